@@ -1,6 +1,10 @@
 #include "FrameStream.h"
 #include "RenderStream.h"
 
+#include "RenderStreamMemory.h"
+#include "RenderStreamStats.h"
+#include "RenderStreamWatchdog.h"
+
 #include "RSUCHelpers.inl"
 
 FFrameStream::FFrameStream()
@@ -8,6 +12,7 @@ FFrameStream::FFrameStream()
 
 FFrameStream::~FFrameStream()
 {
+    ReleaseNativeResources();
 }
 
 void FFrameStream::SendFrame_RenderingThread(FRHICommandListImmediate& RHICmdList, RenderStreamLink::CameraResponseData& FrameData, FRHITexture2D* SourceTexture, const FIntRect& ViewportRect)
@@ -16,11 +21,100 @@ void FFrameStream::SendFrame_RenderingThread(FRHICommandListImmediate& RHICmdLis
     float URight = (float)ViewportRect.Max.X / (float)SourceTexture->GetSizeX();
     float VTop = (float)ViewportRect.Min.Y / (float)SourceTexture->GetSizeY();
     float VBottom = (float)ViewportRect.Max.Y / (float)SourceTexture->GetSizeY();
-    RSUCHelpers::SendFrame(m_handle, m_bufTexture, m_fence, m_fenceValue, RHICmdList, FrameData, SourceTexture, SourceTexture->GetSizeXY(), { ULeft, URight }, { VTop, VBottom });
+
+    ResolveGPUTimings_RenderingThread();
+
+    // Time the copy on the GPU, unless too many earlier results are still outstanding.
+    FGPUTimingQueries Queries;
+    if (m_gpuTimingQueries.Num() < MaxPendingGPUTimings)
+    {
+        if (!m_gpuQueryPool)
+            m_gpuQueryPool = RHICreateRenderQueryPool(RQT_AbsoluteTime, MaxPendingGPUTimings * 2);
+        Queries.Begin = m_gpuQueryPool->AllocateQuery();
+        Queries.End = m_gpuQueryPool->AllocateQuery();
+        Queries.FrameNumber = GFrameNumberRenderThread;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    RSUCHelpers::CopyFrame(m_bufTexture, RHICmdList, SourceTexture, SourceTexture->GetSizeXY(), { ULeft, URight }, { VTop, VBottom }, Queries.Begin.GetQuery(), Queries.End.GetQuery());
+    m_copyTime.store(float((FPlatformTime::Seconds() - StartTime) * 1000.0), std::memory_order_relaxed);
+
+    if (Queries.Begin.IsValid() && Queries.End.IsValid())
+        m_gpuTimingQueries.Add(MoveTemp(Queries));
+
+    ResendFrame_RenderingThread(RHICmdList, FrameData);
+}
+
+void FFrameStream::ResendFrame_RenderingThread(FRHICommandListImmediate& RHICmdList, RenderStreamLink::CameraResponseData& FrameData)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SendFrame);
+    const double StartTime = FPlatformTime::Seconds();
+    RenderStreamWatchdog().Enter(ERenderStreamHeartbeat::Send, TEXT("rs_sendFrame"), *m_streamName);
+    RSUCHelpers::SendBuffer(m_handle, m_bufTexture, m_fence, m_fenceValue, RHICmdList, FrameData);
     m_fenceValue += 2;
+    const bool Recreate = RenderStreamWatchdog().Leave(ERenderStreamHeartbeat::Send);
+    m_sendTime.store(float((FPlatformTime::Seconds() - StartTime) * 1000.0), std::memory_order_relaxed);
+
+    if (Recreate)
+        RecreateResources_RenderingThread(RHICmdList);
 }
 
-bool FFrameStream::Setup(const FString& name, const FIntPoint& Resolution, const FString& Channel, const RenderStreamLink::ProjectionClipping& Clipping, RenderStreamLink::StreamHandle Handle, RenderStreamLink::RSPixelFormat fmt)
+void FFrameStream::RecreateResources_RenderingThread(FRHICommandListImmediate& RHICmdList)
+{
+    UE_LOG(LogRenderStream, Warning, TEXT("Recreating the resources of stream '%s' after a stalled send"), *m_streamName);
+    {
+        // The CPU waits here for the GPU, which itself waits on the stream fence for d3 to release the texture.
+        FRenderStreamWatchdog::FScope Watchdog(ERenderStreamHeartbeat::Send, TEXT("stream fence wait"), *m_streamName);
+        RHICmdList.SubmitCommandsAndFlushGPU();
+    }
+
+    m_bufTexture.SafeRelease();
+    ReleaseNativeResources();
+    m_fenceValue = 1;
+
+    if (!CreateNativeResources_AnyThread(m_format) || !FinishSetup(m_format))
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Failed to recreate stream '%s': %s"), *m_streamName, *m_setupError);
+        return;
+    }
+    RSUCHelpers::WarmUp(m_bufTexture, RHICmdList);
+}
+
+void FFrameStream::WarmUp_RenderingThread(FRHICommandListImmediate& RHICmdList)
+{
+    if (!m_bufTexture)
+        return;
+
+    RSUCHelpers::WarmUp(m_bufTexture, RHICmdList);
+    if (!m_gpuQueryPool)
+        m_gpuQueryPool = RHICreateRenderQueryPool(RQT_AbsoluteTime, MaxPendingGPUTimings * 2);
+}
+
+void FFrameStream::ResolveGPUTimings_RenderingThread()
+{
+    while (m_gpuTimingQueries.Num() > 0)
+    {
+        const FGPUTimingQueries& Oldest = m_gpuTimingQueries[0];
+        if (GFrameNumberRenderThread - Oldest.FrameNumber < GPUTimingLatency)
+            break;
+
+        uint64 BeginTime = 0;
+        uint64 EndTime = 0;
+        // Never wait on the GPU, results which are not ready yet are picked up on a later frame.
+        if (!RHIGetRenderQueryResult(Oldest.Begin.GetQuery(), BeginTime, false) ||
+            !RHIGetRenderQueryResult(Oldest.End.GetQuery(), EndTime, false))
+        {
+            break;
+        }
+
+        // Absolute time queries are in microseconds.
+        const float CopyGPUTime = EndTime > BeginTime ? float(EndTime - BeginTime) / 1000.f : 0.f;
+        m_copyGPUTime.store(CopyGPUTime, std::memory_order_relaxed);
+        m_gpuTimingQueries.RemoveAt(0); // releases the queries back to the pool
+    }
+}
+
+bool FFrameStream::SetupHeadless(const FString& name, const FIntPoint& Resolution, const FString& Channel, const RenderStreamLink::ProjectionClipping& Clipping, RenderStreamLink::StreamHandle Handle)
 {
     if (m_handle != 0)
         return false; // already have a stream handle call stop first
@@ -31,12 +125,71 @@ bool FFrameStream::Setup(const FString& name, const FIntPoint& Resolution, const
     m_resolution = Resolution;
     m_streamName = name;
 
-    if (!RSUCHelpers::CreateStreamResources(m_bufTexture, m_fence, m_resolution, fmt))
-        return false; // helper method logs on failure
+    const std::string StatPrefix = TCHAR_TO_UTF8(*m_streamName);
+    m_copyTimeStatName = StatPrefix + " Copy Time";
+    m_sendTimeStatName = StatPrefix + " Send Time";
+    m_copyGPUTimeStatName = StatPrefix + " RS Copy GPU ms";
 
-    if (m_handle == 0) {
-        UE_LOG(LogRenderStream, Error, TEXT("Unable to create stream"));
-        RenderStreamStatus().Output("Error: Unable to create stream", RSSTATUS_RED);
+    return true;
+}
+
+bool FFrameStream::CreateNativeResources_AnyThread(RenderStreamLink::RSPixelFormat Fmt)
+{
+    RS_LLM_SCOPE(ERenderStreamMemory::Streams);
+    m_format = Fmt;
+    if (m_handle == 0)
+    {
+        m_setupError = TEXT("Unable to create stream");
+        return false;
+    }
+
+    const TCHAR* Error = nullptr;
+    if (!RSUCHelpers::CreateNativeResources(m_fence, m_pendingTexture, Error, m_resolution, Fmt))
+    {
+        m_setupError = Error;
+        ReleaseNativeResources();
+        return false;
+    }
+    return true;
+}
+
+bool FFrameStream::FinishSetup(RenderStreamLink::RSPixelFormat Fmt)
+{
+    RS_LLM_SCOPE(ERenderStreamMemory::Streams);
+    if (!RSUCHelpers::CreateRHIResources(m_bufTexture, m_pendingTexture, m_resolution, Fmt))
+    {
+        m_setupError = TEXT("Failed to create the stream texture.");
+        ReleaseNativeResources();
+        return false;
+    }
+    m_gpuMemory = RSUCHelpers::TextureMemorySize(m_bufTexture, m_pendingTexture);
+    m_pendingTexture = nullptr;
+    return true;
+}
+
+void FFrameStream::ReleaseNativeResources()
+{
+    if (m_pendingTexture)
+    {
+        m_pendingTexture->Release();
+        m_pendingTexture = nullptr;
+    }
+    if (m_fence)
+    {
+        m_fence->Release();
+        m_fence = nullptr;
+    }
+}
+
+bool FFrameStream::Setup(const FString& name, const FIntPoint& Resolution, const FString& Channel, const RenderStreamLink::ProjectionClipping& Clipping, RenderStreamLink::StreamHandle Handle, RenderStreamLink::RSPixelFormat fmt)
+{
+    if (!SetupHeadless(name, Resolution, Channel, Clipping, Handle))
+        return false;
+
+    if (!CreateNativeResources_AnyThread(fmt) || !FinishSetup(fmt))
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("%s"), *m_setupError);
+        RenderStreamStatus().Output(TEXT("Error: ") + m_setupError, RSSTATUS_RED);
         return false;
     }
     UE_LOG(LogRenderStream, Log, TEXT("Created stream '%s'"), *m_streamName);
@@ -44,3 +197,9 @@ bool FFrameStream::Setup(const FString& name, const FIntPoint& Resolution, const
     
     return true;
 }
+
+uint64 FFrameStream::CPUMemory() const
+{
+    return sizeof(*this) + m_streamName.GetAllocatedSize() + m_channel.GetAllocatedSize() + m_setupError.GetAllocatedSize() +
+        m_copyTimeStatName.capacity() + m_sendTimeStatName.capacity() + m_copyGPUTimeStatName.capacity() + m_gpuTimingQueries.GetAllocatedSize();
+}
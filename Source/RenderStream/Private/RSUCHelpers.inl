@@ -22,22 +22,43 @@ class D3D12Fence;
 
 namespace RSUCHelpers
 {
-    void SendFrame(const RenderStreamLink::StreamHandle Handle,
-        FTextureRHIRef BufTexture,
-        ID3D12Fence* Fence,
-        int FenceValue,
+    // Copy and convert the source into BufTexture, and submit the copy to the GPU.
+    // Optional timestamp queries are written around the copy pass, results are read back by the caller.
+    void CopyFrame(FTextureRHIRef BufTexture,
         FRHICommandListImmediate& RHICmdList,
-        RenderStreamLink::CameraResponseData FrameData,
         FRHITexture2D* InSourceTexture,
         FIntPoint Point,
         FVector2D CropU,
-        FVector2D CropV);
+        FVector2D CropV,
+        FRHIRenderQuery* BeginQuery = nullptr,
+        FRHIRenderQuery* EndQuery = nullptr);
+
+    // Send the contents of BufTexture to d3, either after CopyFrame or as they are to re-send the last frame.
+    void SendBuffer(const RenderStreamLink::StreamHandle Handle,
+        FTextureRHIRef BufTexture,
+        ID3D12Fence* Fence,
+        int FenceValue,
+        FRHICommandListImmediate& RHICmdList,
+        RenderStreamLink::CameraResponseData FrameData);
 
-    bool CreateStreamResources(/*InOut*/ FTextureRHIRef& BufTexture,
-                               /*InOut*/ ID3D12Fence*& Fence,
+    // Stream resources are created in two steps so those of many streams can be created in parallel.
+    // CreateNativeResources makes the device calls and is safe on any thread, Error is set when it fails.
+    bool CreateNativeResources(/*InOut*/ ID3D12Fence*& Fence,
+                               /*Out*/ ID3D12Resource*& Texture,
+                               /*Out*/ const TCHAR*& Error,
                                const FIntPoint& Resolution,
                                RenderStreamLink::RSPixelFormat pixelFormat);
+    // Wraps the native texture for the RHI, or creates it on D3D11 which needs no native resources.
+    bool CreateRHIResources(/*InOut*/ FTextureRHIRef& BufTexture,
+                            ID3D12Resource* Texture,
+                            const FIntPoint& Resolution,
+                            RenderStreamLink::RSPixelFormat pixelFormat);
 
+    // Video memory BufTexture takes, Texture is its native resource when it has one.
+    uint64 TextureMemorySize(FTextureRHIRef BufTexture, ID3D12Resource* Texture);
+
+    // Clear BufTexture and create the copy PSO for its format, so neither happens in the first frame d3 requests.
+    void WarmUp(FTextureRHIRef BufTexture, FRHICommandListImmediate& RHICmdList);
 
 }
 
@@ -93,23 +114,9 @@ void RSResizeCopy::SetParameters(FRHICommandList& CommandList, TRefCountPtr<FRHI
     SetUniformBufferParameter(CommandList, CommandList.GetBoundPixelShader(), GetUniformBufferParameter<RSResizeCopyUB>(), Data);
 }
 
-void RSUCHelpers::SendFrame(const RenderStreamLink::StreamHandle Handle, 
-                            FTextureRHIRef BufTexture,
-                            ID3D12Fence* Fence,
-                            int FenceValue,
-                            FRHICommandListImmediate& RHICmdList, 
-                            RenderStreamLink::CameraResponseData FrameData, 
-                            FRHITexture2D* InSourceTexture, 
-                            FIntPoint Point,
-                            FVector2D CropU,
-                            FVector2D CropV)
+// Bind the copy PSO for the current render pass, the RHI creates it on first use for each render target format.
+static TShaderMapRef<RSResizeCopy> SetCopyPipelineState(FRHICommandListImmediate& RHICmdList, FGraphicsPipelineStateInitializer& GraphicsPSOInit)
 {
-    // convert the source with a draw call
-    FGraphicsPipelineStateInitializer GraphicsPSOInit;
-    FRHITexture* RenderTarget = BufTexture.GetReference();
-    FRHIRenderPassInfo RPInfo(RenderTarget, ERenderTargetActions::DontLoad_Store);
-    RHICmdList.BeginRenderPass(RPInfo, TEXT("MediaCapture"));
-
     RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
 
     GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
@@ -127,6 +134,28 @@ void RSUCHelpers::SendFrame(const RenderStreamLink::StreamHandle Handle,
     TShaderMapRef<RSResizeCopy> ConvertShader(ShaderMap);
     GraphicsPSOInit.BoundShaderState.PixelShaderRHI = ConvertShader.GetPixelShader();
     SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+    return ConvertShader;
+}
+
+void RSUCHelpers::CopyFrame(FTextureRHIRef BufTexture,
+                            FRHICommandListImmediate& RHICmdList, 
+                            FRHITexture2D* InSourceTexture, 
+                            FIntPoint Point,
+                            FVector2D CropU,
+                            FVector2D CropV,
+                            FRHIRenderQuery* BeginQuery,
+                            FRHIRenderQuery* EndQuery)
+{
+    if (BeginQuery)
+        RHICmdList.EndRenderQuery(BeginQuery);
+
+    // convert the source with a draw call
+    FGraphicsPipelineStateInitializer GraphicsPSOInit;
+    FRHITexture* RenderTarget = BufTexture.GetReference();
+    FRHIRenderPassInfo RPInfo(RenderTarget, ERenderTargetActions::DontLoad_Store);
+    RHICmdList.BeginRenderPass(RPInfo, TEXT("MediaCapture"));
+
+    TShaderMapRef<RSResizeCopy> ConvertShader = SetCopyPipelineState(RHICmdList, GraphicsPSOInit);
     auto streamTexSize = BufTexture->GetTexture2D()->GetSizeXY();
     ConvertShader->SetParameters(RHICmdList, InSourceTexture, Point);
 
@@ -145,9 +174,34 @@ void RSUCHelpers::SendFrame(const RenderStreamLink::StreamHandle Handle,
 
     RHICmdList.EndRenderPass();
 
-    RHICmdList.SubmitCommandsAndFlushGPU();
-    FRHITexture2D* tex2d2 = BufTexture->GetTexture2D();
-    auto point2 = tex2d2->GetSizeXY();
+    if (EndQuery)
+        RHICmdList.EndRenderQuery(EndQuery);
+
+    // Hand the copy to the GPU queue ahead of the fence SendBuffer signals on it, without waiting for the GPU.
+    RHICmdList.SubmitCommandsHint();
+    RHICmdList.ImmediateFlush(EImmediateFlushType::FlushRHIThread);
+}
+
+void RSUCHelpers::WarmUp(FTextureRHIRef BufTexture, FRHICommandListImmediate& RHICmdList)
+{
+    FGraphicsPipelineStateInitializer GraphicsPSOInit;
+    FRHITexture* RenderTarget = BufTexture.GetReference();
+    FRHIRenderPassInfo RPInfo(RenderTarget, ERenderTargetActions::Clear_Store);
+    RHICmdList.BeginRenderPass(RPInfo, TEXT("RenderStreamWarmUp"));
+
+    SetCopyPipelineState(RHICmdList, GraphicsPSOInit);
+    RHICmdList.Transition(FRHITransitionInfo(BufTexture, ERHIAccess::Unknown, ERHIAccess::SRVGraphics));
+
+    RHICmdList.EndRenderPass();
+}
+
+void RSUCHelpers::SendBuffer(const RenderStreamLink::StreamHandle Handle,
+                             FTextureRHIRef BufTexture,
+                             ID3D12Fence* Fence,
+                             int FenceValue,
+                             FRHICommandListImmediate& RHICmdList,
+                             RenderStreamLink::CameraResponseData FrameData)
+{
     void* resource = BufTexture->GetTexture2D()->GetNativeResource();
 
     auto toggle = FHardwareInfo::GetHardwareInfo(NAME_RHI);
@@ -183,57 +237,86 @@ void RSUCHelpers::SendFrame(const RenderStreamLink::StreamHandle Handle,
     }
 }
 
-bool RSUCHelpers::CreateStreamResources(/*InOut*/ FTextureRHIRef& BufTexture,
-                                        /*InOut*/ ID3D12Fence*& Fence,
-                                        const FIntPoint& Resolution,
-                                        RenderStreamLink::RSPixelFormat rsFormat)
+struct FRSFormat
 {
-    FRHIResourceCreateInfo info{ FClearValueBinding::Green };
-
+    DXGI_FORMAT dxgi;
+    EPixelFormat ue;
+};
 
-    struct
-    {
-        DXGI_FORMAT dxgi;
-        EPixelFormat ue;
-    } formatMap[] = {
+static FRSFormat GetRSFormat(RenderStreamLink::RSPixelFormat rsFormat)
+{
+    static const FRSFormat formatMap[] = {
         { DXGI_FORMAT_UNKNOWN, EPixelFormat::PF_Unknown },      // RS_FMT_INVALID
         { DXGI_FORMAT_B8G8R8A8_UNORM, EPixelFormat::PF_R8G8B8A8_UINT },     // RS_FMT_BGRA8
         { DXGI_FORMAT_B8G8R8X8_UNORM, EPixelFormat::PF_R8G8B8A8_UINT },     // RS_FMT_BGRX8
         { DXGI_FORMAT_R32G32B32A32_FLOAT, EPixelFormat::PF_A32B32G32R32F}, // RS_FMT_RGBA32F
     };
-    const auto format = formatMap[rsFormat];
+    return formatMap[rsFormat];
+}
+
+bool RSUCHelpers::CreateNativeResources(/*InOut*/ ID3D12Fence*& Fence,
+                                        /*Out*/ ID3D12Resource*& Texture,
+                                        /*Out*/ const TCHAR*& Error,
+                                        const FIntPoint& Resolution,
+                                        RenderStreamLink::RSPixelFormat rsFormat)
+{
+    Texture = nullptr;
+    Error = nullptr;
 
     auto toggle = FHardwareInfo::GetHardwareInfo(NAME_RHI);
     if (toggle == "D3D12")
     {
         // unreal won't let us make a texture with the shared flag that isn't 8bit BGRA, so we have to handle it ourselves
-        auto rhi12 =  static_cast<FD3D12DynamicRHI*>(GDynamicRHI);
+        // the device is free threaded, which is what lets streams create these in parallel
+        FRHIResourceCreateInfo info{ FClearValueBinding::Green };
         auto dx12device = static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice());
         if (dx12device->CreateFence(0, D3D12_FENCE_FLAG_SHARED, __uuidof(ID3D12Fence), reinterpret_cast<void**>(&Fence)) != 0)
         {
-            UE_LOG(LogRenderStream, Error, TEXT("Failed to create DX12 fence."));
-            RenderStreamStatus().Output("Error: Failed create a DX12 fence.", RSSTATUS_RED);
+            Error = TEXT("Failed to create DX12 fence.");
             return false;
         }
 
-        ID3D12Resource* outTex = nullptr;
-        if (!DX12CreateSharedRenderTarget2D(dx12device, Resolution.X, Resolution.Y, format.dxgi, info, &outTex, L"DUERS_Target"))
+        if (!DX12CreateSharedRenderTarget2D(dx12device, Resolution.X, Resolution.Y, GetRSFormat(rsFormat).dxgi, info, &Texture, L"DUERS_Target"))
         {
-            UE_LOG(LogRenderStream, Error, TEXT("Failed to create DX12 render target."));
-            RenderStreamStatus().Output("Error: Failed create a DX12 render target.", RSSTATUS_RED);
+            Error = TEXT("Failed to create DX12 render target.");
             return false;
         }
+    }
+    else if (toggle != "D3D11")
+    {
+        Error = TEXT("RHI backend not supported for uncompressed RenderStream.");
+        return false;
+    }
+    return true;
+}
 
-        BufTexture = rhi12->RHICreateTexture2DFromResource(format.ue, ETextureCreateFlags::TexCreate_Shared | ETextureCreateFlags::TexCreate_RenderTargetable, FClearValueBinding::Green, outTex);
+bool RSUCHelpers::CreateRHIResources(/*InOut*/ FTextureRHIRef& BufTexture,
+                                     ID3D12Resource* Texture,
+                                     const FIntPoint& Resolution,
+                                     RenderStreamLink::RSPixelFormat rsFormat)
+{
+    const FRSFormat format = GetRSFormat(rsFormat);
+    if (Texture)
+    {
+        auto rhi12 = static_cast<FD3D12DynamicRHI*>(GDynamicRHI);
+        BufTexture = rhi12->RHICreateTexture2DFromResource(format.ue, ETextureCreateFlags::TexCreate_Shared | ETextureCreateFlags::TexCreate_RenderTargetable, FClearValueBinding::Green, Texture);
     }
-    else if (toggle == "D3D11")
+    else
     {
+        FRHIResourceCreateInfo info{ FClearValueBinding::Green };
         BufTexture = RHICreateTexture2D(Resolution.X, Resolution.Y, format.ue, 1, 1, ETextureCreateFlags::TexCreate_RenderTargetable, info);
     }
-    else
+    return BufTexture.IsValid();
+}
+
+uint64 RSUCHelpers::TextureMemorySize(FTextureRHIRef BufTexture, ID3D12Resource* Texture)
+{
+    if (Texture)
     {
-        UE_LOG(LogRenderStream, Error, TEXT("RHI backend not supported for uncompressed RenderStream."));
-        return false;
+        // Created outside the RHI, which does not know its size.
+        auto dx12device = static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice());
+        const D3D12_RESOURCE_DESC Desc = Texture->GetDesc();
+        return dx12device->GetResourceAllocationInfo(0, 1, &Desc).SizeInBytes;
     }
-    return true;
-}
\ No newline at end of file
+    return BufTexture.IsValid() ? RHIComputeMemorySize(BufTexture) : 0;
+}
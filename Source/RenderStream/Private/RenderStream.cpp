@@ -4,13 +4,22 @@
 
 #include "RenderStreamSettings.h"
 #include "RenderStreamStatus.h"
+#include "RenderStreamMonitor.h"
+#include "RenderStreamSchemaIndex.h"
+#include "RenderStreamStartup.h"
+#include "RenderStreamWatchdog.h"
+#include "RenderStreamDmx.h"
+#include "RenderStreamMemory.h"
+#include "RenderStreamChannelDefinition.h"
 #include "RenderStreamSceneSelector.h"
 #include "SceneSelector_None.h"
 #include "SceneSelector_StreamingLevels.h"
 #include "SceneSelector_Maps.h"
+#include "SceneSelector_ResidentLevels.h"
 
 #include "Core/Public/Modules/ModuleManager.h"
 #include "CoreUObject/Public/Misc/PackageName.h"
+#include "Async/Async.h"
 #include "Misc/CoreDelegates.h"
 #include "Json/Public/Serialization/JsonSerializer.h"
 #include "Misc/FileHelper.h"
@@ -18,6 +27,9 @@
 #include "Kismet/GameplayStatics.h"
 #include "Engine/LevelScriptActor.h"
 #include "Engine/World.h"
+#include "Engine/LevelStreaming.h"
+#include "Camera/CameraActor.h"
+#include "UObject/UObjectHash.h"
 #include "ShaderCore.h"
 
 #include "Interfaces/IPluginManager.h"
@@ -44,141 +56,147 @@
 #include <vector>
 
 #include "RenderStreamStats.h"
-#include "ShaderCompiler.h"
 #include "Stats/StatsData.h"
 
 DEFINE_LOG_CATEGORY(LogRenderStream);
 
 #define LOCTEXT_NAMESPACE "FRenderStreamModule"
 
-class FRenderStreamMonitor : public FRunnable
+static const FName DisplayClusterModuleName(TEXT("DisplayCluster"));
+
+void FRenderStreamModule::StartupModule()
 {
-public:
-    virtual ~FRenderStreamMonitor()
-    {
-        if (Thread)
-            Close();
-    }
+    FRenderStreamStartupTimeline::FScope Stage(TEXT("Module startup"));
+    RegisterRenderStreamLLMTags();
+    m_World = nullptr;
 
-    void Open()
-    {
-        bStopThread = false;
-        Thread = FRunnableThread::Create(
-            this,
-            TEXT("RenderStreamMonitor")
-        );
-    }
+    FString ShaderDirectory = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("DisguiseUERenderStream"))->GetBaseDir(), TEXT("Shaders"));
+    AddShaderSourceDirectoryMapping("/DisguiseUERenderStream", ShaderDirectory);
 
-    void Close()
-    {
-        delete Thread;
-        Thread = nullptr;
-    }
+    // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+    RenderStreamStatus().InputOutput("Initialising stream", "Waiting for data from d3", RSSTATUS_ORANGE);
 
-private:
-    virtual uint32 Run() override
+    // Loading and initialising the library reads the registry and loads d3's DLLs, none of which the engine needs
+    // until it has initialised, so it overlaps with that and is waited on in FinishLoadingLibrary.
+    m_logDevice = MakeShared<FRenderStreamLogOutputDevice, ESPMode::ThreadSafe>();
+    m_libraryLoad = Async(EAsyncExecution::Thread, []() -> TOptional<RenderStreamLink::RS_ERROR>
     {
-        while (!bStopThread)
         {
-            if (GShaderCompilingManager && GShaderCompilingManager->IsCompiling())
-            {
-                const FString Message = FString::Printf(TEXT("Compiling %d Shaders"), GShaderCompilingManager->GetNumRemainingJobs());
-                RenderStreamLink::instance().rs_setNewStatusMessage(TCHAR_TO_ANSI(*Message));
-                bIsClear = false;
-            }
-            else if (!bIsClear)
-            {
-                RenderStreamLink::instance().rs_setNewStatusMessage("");
-                bIsClear = true;
-            }
-
-            FPlatformProcess::Sleep(1);
+            FRenderStreamStartupTimeline::FScope LoadStage(TEXT("Library load"));
+            if (!RenderStreamLink::instance().loadExplicit())
+                return {};
         }
+        FRenderStreamStartupTimeline::FScope InitialiseStage(TEXT("Library initialise"));
+        return RenderStreamLink::instance().rs_initialise(RENDER_STREAM_VERSION_MAJOR, RENDER_STREAM_VERSION_MINOR);
+    });
 
-        RenderStreamLink::instance().rs_setNewStatusMessage("");
-        bIsClear = true;
-        return 0;
-    }
-
-    virtual void Stop() override
+#if !WITH_EDITOR
+    // The editor rewrites the index, it is only held open briefly there, see TakeSchemaIndex.
+    m_schemaIndexLoad = Async(EAsyncExecution::Thread, []()
     {
-        bStopThread = true;
-    }
-
-    FRunnableThread* Thread = nullptr;
-    bool bStopThread = false;
-    bool bIsClear = false;
-};
+        FRenderStreamStartupTimeline::FScope IndexStage(TEXT("Schema index"));
+        return TSharedPtr<FRenderStreamSchemaIndex>(FRenderStreamSchemaIndex::Open(FRenderStreamSchemaIndex::DefaultPath()).Release());
+    });
+#endif
 
-FRenderStreamMonitor Monitor;
+    FCoreDelegates::OnPostEngineInit.AddRaw(this, &FRenderStreamModule::OnPostEngineInit);
 
-static const FName DisplayClusterModuleName(TEXT("DisplayCluster"));
+    if (IDisplayCluster::IsAvailable())
+    {
+        // Should not happen, but handle just in case
+        UE_LOG(LogRenderStream, Warning, TEXT("Unexpected module startup order"));
+        OnModulesChanged(DisplayClusterModuleName, EModuleChangeReason::ModuleLoaded);
+    }
+    else
+    {
+        FModuleManager::Get().OnModulesChanged().AddRaw(this, &FRenderStreamModule::OnModulesChanged);
+    }
+}
 
-void FRenderStreamModule::StartupModule()
+bool FRenderStreamModule::FinishLoadingLibrary()
 {
-    m_World = nullptr;
-
-    FString ShaderDirectory = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("DisguiseUERenderStream"))->GetBaseDir(), TEXT("Shaders"));
-    AddShaderSourceDirectoryMapping("/DisguiseUERenderStream", ShaderDirectory);
+    if (!m_libraryLoad.IsValid())
+        return RenderStreamLink::instance().isAvailable();
 
-    // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-    RenderStreamStatus().InputOutput("Initialising stream", "Waiting for data from d3", RSSTATUS_ORANGE);
+    const double WaitStartTime = FPlatformTime::Seconds();
+    const TOptional<RenderStreamLink::RS_ERROR> Result = m_libraryLoad.Get();
+    m_libraryLoad.Reset();
+    RenderStreamStartup().Add(TEXT("Library wait"), WaitStartTime, FPlatformTime::Seconds());
 
-    if (!RenderStreamLink::instance().loadExplicit())
+    if (!Result.IsSet())
     {
         UE_LOG(LogRenderStream, Error, TEXT ("Failed to load RenderStream DLL - d3 not installed?"));
         RenderStreamStatus().InputOutput("Error", "Failed to load RenderStream DLL - d3 not installed?", RSSTATUS_RED);
+        m_logDevice.Reset();
+        return false;
     }
-    else
-    {
-        m_logDevice = MakeShared<FRenderStreamLogOutputDevice, ESPMode::ThreadSafe>();
 
-        int errCode = RenderStreamLink::instance().rs_initialise(RENDER_STREAM_VERSION_MAJOR, RENDER_STREAM_VERSION_MINOR);
-        if (errCode != RenderStreamLink::RS_ERROR_SUCCESS)
+    const RenderStreamLink::RS_ERROR errCode = Result.GetValue();
+    if (errCode != RenderStreamLink::RS_ERROR_SUCCESS)
+    {
+        if (errCode == RenderStreamLink::RS_ERROR_INCOMPATIBLE_VERSION)
+        {
+            UE_LOG(LogRenderStream, Error, TEXT("Unsupported RenderStream library, expected version %i.%i"), RENDER_STREAM_VERSION_MAJOR, RENDER_STREAM_VERSION_MINOR);
+            RenderStreamStatus().InputOutput("Error", "Unsupported RenderStream library", RSSTATUS_RED);
+        }
+        else
         {
-            if (errCode == RenderStreamLink::RS_ERROR_INCOMPATIBLE_VERSION)
-            {
-                UE_LOG(LogRenderStream, Error, TEXT("Unsupported RenderStream library, expected version %i.%i"), RENDER_STREAM_VERSION_MAJOR, RENDER_STREAM_VERSION_MINOR);
-                RenderStreamStatus().InputOutput("Error", "Unsupported RenderStream library", RSSTATUS_RED);
-                RenderStreamLink::instance().unloadExplicit();
-                return;
-            }
-
             UE_LOG(LogRenderStream, Error, TEXT("Unable to initialise RenderStream library error code %d"), errCode);
             RenderStreamStatus().InputOutput("Error", "Unable to initialise RenderStream library", RSSTATUS_RED);
-            RenderStreamLink::instance().unloadExplicit();
-            return;
         }
-
-        FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FRenderStreamModule::OnPostLoadMapWithWorld);
-        FCoreDelegates::OnBeginFrame.AddRaw(this, &FRenderStreamModule::OnBeginFrame);
-        FCoreDelegates::OnEndFrame.AddRaw(this, &FRenderStreamModule::OnEndFrame);
-        FCoreDelegates::OnPostEngineInit.AddRaw(this, &FRenderStreamModule::OnPostEngineInit);
-        Monitor.Open();
+        RenderStreamLink::instance().unloadExplicit();
+        m_logDevice.Reset();
+        return false;
     }
 
-    if (IDisplayCluster::IsAvailable())
+    FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FRenderStreamModule::OnPostLoadMapWithWorld);
+    FCoreDelegates::OnBeginFrame.AddRaw(this, &FRenderStreamModule::OnBeginFrame);
+    FCoreDelegates::OnEndFrame.AddRaw(this, &FRenderStreamModule::OnEndFrame);
     {
-        // Should not happen, but handle just in case
-        UE_LOG(LogRenderStream, Warning, TEXT("Unexpected module startup order"));
-        OnModulesChanged(DisplayClusterModuleName, EModuleChangeReason::ModuleLoaded);
+        RS_LLM_SCOPE(ERenderStreamMemory::Diagnostics);
+        m_trace = MakeUnique<FRenderStreamTrace>(TraceFrames);
+        // Only nodes publish, a commandlet or editor loading the module must not take over a node's page.
+        if (!IsRunningCommandlet() && !GIsEditor)
+            m_telemetry.Open();
     }
-    else
+    RenderStreamMonitor().Open();
+    m_logDevice->Activate();
+    return true;
+}
+
+TSharedPtr<FRenderStreamSchemaIndex> FRenderStreamModule::TakeSchemaIndex()
+{
+    if (m_schemaIndexLoad.IsValid())
     {
-        FModuleManager::Get().OnModulesChanged().AddRaw(this, &FRenderStreamModule::OnModulesChanged);
+        TSharedPtr<FRenderStreamSchemaIndex> Index = m_schemaIndexLoad.Get();
+        m_schemaIndexLoad.Reset();
+        return Index;
     }
+    return TSharedPtr<FRenderStreamSchemaIndex>(FRenderStreamSchemaIndex::Open(FRenderStreamSchemaIndex::DefaultPath()).Release());
 }
 
 void FRenderStreamModule::ShutdownModule()
 {
+    // Never leave the background loads running past the module.
+    FinishLoadingLibrary();
+    if (m_schemaIndexLoad.IsValid())
+        m_schemaIndexLoad.Wait();
+    m_schemaIndexLoad.Reset();
+
+    FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+    FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+
     if (!RenderStreamLink::instance().isAvailable())
         return;
 
     UE_LOG(LogRenderStream, Log, TEXT("Shutting down RenderStream"));
 
-    Monitor.Close();
-
-    FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+    m_scheduler.Close();
+    m_clusterTimings.Close();
+    RenderStreamWatchdog().Close();
+    RenderStreamDmxReceiver().Close();
+    RenderStreamMonitor().Close();
+    m_telemetry.Close();
 
     StreamPool.Reset();
 
@@ -201,7 +219,10 @@ void FRenderStreamModule::ShutdownModule()
 
     FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
     FCoreDelegates::OnBeginFrame.RemoveAll(this);
-    FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+    FCoreDelegates::OnEndFrame.RemoveAll(this);
+
+    // Forward anything still queued while d3 is listening.
+    m_logDevice.Reset();
 
     // This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
     // we call this function before unloading the module.
@@ -228,15 +249,28 @@ void FRenderStreamModule::LoadSchemas(const UWorld& World)
         OnPostEngineInit();
         FCoreDelegates::OnPostEngineInit.RemoveAll(this);
     }
-    m_sceneSelector->LoadSchemas(World);
+    {
+        FRenderStreamStartupTimeline::FScope Stage(TEXT("Schema load"));
+        // Released again straight away, the index can't be replaced while it is mapped.
+        const TSharedPtr<FRenderStreamSchemaIndex> Index = TakeSchemaIndex();
+        m_sceneSelector->LoadSchemas(World, Index.Get());
+    }
     m_World = &World;
+
+    // The first scene is loaded, the node is up.
+    RenderStreamStartup().Log();
 }
 
 void FRenderStreamModule::ApplyScene(uint32_t sceneId)
 {
     check(m_sceneSelector != nullptr);
     check(m_World != nullptr);
+    SCOPE_CYCLE_COUNTER(STAT_ApplyScene);
+    RS_LLM_SCOPE(ERenderStreamMemory::Scenes);
+    const double StartTime = FPlatformTime::Seconds();
     m_sceneSelector->ApplyScene(*m_World, sceneId);
+    SceneApplyTime = (FPlatformTime::Seconds() - StartTime) * 1000.f;
+    ParameterApplyTime = m_sceneSelector->TakeParameterApplyTime();
 }
 
 bool FRenderStreamModule::PopulateStreamPool()
@@ -270,6 +304,8 @@ bool FRenderStreamModule::PopulateStreamPool()
 
         const RenderStreamLink::StreamDescriptions* header = nBytes >= sizeof(RenderStreamLink::StreamDescriptions) ? reinterpret_cast<const RenderStreamLink::StreamDescriptions*>(descMem.data()) : nullptr;
         const size_t numStreams = header ? header->nStreams : 0;
+        RenderStreamMonitor().SetStatus(ERenderStreamStatusSource::Streams, FString::Printf(TEXT("Configuring %d Streams"), int32(numStreams)));
+        TArray<FStreamPool::FStreamDescription> NewStreams;
         for (size_t i = 0; i < numStreams; ++i)
         {
             const RenderStreamLink::StreamDescription& description = header->streams[i];
@@ -279,30 +315,136 @@ bool FRenderStreamModule::PopulateStreamPool()
             if (!StreamPool->GetStream(Name))
             {
                 UE_LOG(LogRenderStream, Log, TEXT("Discovered new stream %s at %dx%d"), *Name, Resolution.X, Resolution.Y);
-                StreamPool->AddNewStreamToPool(Name, Resolution, Channel, description.clipping, description.handle, description.format);
+                NewStreams.Add({ Name, Resolution, Channel, description.clipping, description.handle, description.format });
             }
         }
 
+        if (NewStreams.Num() > 0)
+        {
+            const int32 NumAdded = StreamPool->AddNewStreamsToPool(NewStreams);
+            if (NumAdded < NewStreams.Num())
+                RenderStreamStatus().Output(FString::Printf(TEXT("Error: Failed to create %d of %d streams"), NewStreams.Num() - NumAdded, NewStreams.Num()), RSSTATUS_RED);
+            else
+                RenderStreamStatus().Output("Connected to stream", RSSTATUS_GREEN);
+        }
+        RenderStreamMonitor().ClearStatus(ERenderStreamStatusSource::Streams);
+
         return true;
     }
     return false;
 }
 
+FString FRenderStreamModule::GetAssignedStream(const FString& ViewportId) const
+{
+    const FString* Assigned = m_syncFrame.m_assignment.Streams.Find(ViewportId);
+    return Assigned ? *Assigned : ViewportId;
+}
+
+void FRenderStreamModule::ApplyStreamAssignment(const FRenderStreamAssignment& Assignment)
+{
+    if (!ProjectionPolicyFactory)
+        return;
+
+    bool Flushed = false;
+    for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : ProjectionPolicyFactory->GetPolicies())
+    {
+        const FString StreamName = GetAssignedStream(Policy->GetViewportId());
+        const TSharedPtr<FFrameStream>& Current = Policy->GetStream();
+        if (Current ? Current->Name().Equals(StreamName, ESearchCase::IgnoreCase) : StreamName.IsEmpty())
+            continue;
+
+        // The rendering thread must be done with the previous stream before the policy lets go of it.
+        if (!Flushed)
+        {
+            FlushRenderingCommands();
+            Flushed = true;
+        }
+        UE_LOG(LogRenderStream, Log, TEXT("Viewport '%s' now renders %s"), *Policy->GetViewportId(), StreamName.IsEmpty() ? TEXT("no stream") : *FString::Printf(TEXT("stream '%s'"), *StreamName));
+        Policy->AssignStream(StreamName);
+    }
+}
+
 void FRenderStreamModule::ApplyCameras(const RenderStreamLink::FrameData& frameData)
 {
-    for (const TSharedPtr<FRenderStreamProjectionPolicy>& policy : ProjectionPolicyFactory->GetPolicies())
+    SCOPE_CYCLE_COUNTER(STAT_ApplyCameras);
+    const double StartTime = FPlatformTime::Seconds();
+
+    const TArray<TSharedPtr<FRenderStreamProjectionPolicy>> Policies = ProjectionPolicyFactory->GetPolicies();
+    m_requestedStreams.Init(false, Policies.Num());
+    m_renderedStreams.Init(false, Policies.Num());
+    m_skippedViews = 0;
+
+    // Derive the frame index from d3's clock so every cluster node agrees on which divided streams render.
+    const uint64 FrameIndex = frameData.frameRateDenominator != 0
+        ? uint64(FMath::RoundToDouble(frameData.tTracked * frameData.frameRateNumerator / frameData.frameRateDenominator))
+        : 0;
+    // Stagger the phases of streams sharing a divisor so the rendered views are spread evenly over frames.
+    int32 DivisorPhases[URenderStreamChannelDefinition::MaxFrameRateDivisor + 1] = {};
+
+    for (int32 PolicyIdx = 0; PolicyIdx < Policies.Num(); ++PolicyIdx)
     {
-        const TSharedPtr<FFrameStream> stream = StreamPool->GetStream(policy->GetViewportId());
-        check(stream);
+        const TSharedPtr<FRenderStreamProjectionPolicy>& policy = Policies[PolicyIdx];
+        const TSharedPtr<FFrameStream>& stream = policy->GetStream();
 
+        // Viewports without a stream are never requested.
         RenderStreamLink::CameraData cameraData;
-        if (RenderStreamLink::instance().rs_getFrameCamera(stream->Handle(), &cameraData) == RenderStreamLink::RS_ERROR_SUCCESS)
+        if (stream && RenderStreamLink::instance().rs_getFrameCamera(stream->Handle(), &cameraData) == RenderStreamLink::RS_ERROR_SUCCESS)
+        {
             policy->ApplyCameraData(frameData, cameraData);
+            m_requestedStreams[PolicyIdx] = cameraData.cameraHandle != 0;
+        }
+
+        const int32 Divisor = policy->GetFrameRateDivisor();
+        const int32 Phase = DivisorPhases[Divisor]++ % Divisor;
+        const bool Rendered = m_requestedStreams[PolicyIdx] && (!policy->HasRenderedFrame() || (FrameIndex + Phase) % Divisor == 0);
+        m_renderedStreams[PolicyIdx] = Rendered;
+        policy->UpdateFrameRate(Rendered);
+
+        if (!Rendered)
+            ++m_skippedViews;
     }
+
+    SET_DWORD_STAT(STAT_SkippedViews, m_skippedViews);
+    CameraApplyTime = (FPlatformTime::Seconds() - StartTime) * 1000.f;
+
+    ENQUEUE_RENDER_COMMAND(RenderStreamRequestedStreams)(
+        [this, Requested = m_requestedStreams, Rendered = m_renderedStreams](FRHICommandListImmediate& RHICmdList)
+        {
+            m_requestedStreams_RenderThread = Requested;
+            m_renderedStreams_RenderThread = Rendered;
+        });
+}
+
+bool FRenderStreamModule::IsStreamRequested(int32 PolicyIdx) const
+{
+    check(IsInGameThread());
+    // Until the first frame from d3 arrives, everything is rendered as before.
+    return !m_requestedStreams.IsValidIndex(PolicyIdx) || m_requestedStreams[PolicyIdx];
+}
+
+bool FRenderStreamModule::IsStreamRendered(int32 PolicyIdx) const
+{
+    check(IsInGameThread());
+    return !m_renderedStreams.IsValidIndex(PolicyIdx) || m_renderedStreams[PolicyIdx];
+}
+
+bool FRenderStreamModule::IsStreamRequested_RenderThread(int32 PolicyIdx) const
+{
+    check(IsInRenderingThread());
+    return !m_requestedStreams_RenderThread.IsValidIndex(PolicyIdx) || m_requestedStreams_RenderThread[PolicyIdx];
+}
+
+bool FRenderStreamModule::IsStreamRendered_RenderThread(int32 PolicyIdx) const
+{
+    check(IsInRenderingThread());
+    return !m_renderedStreams_RenderThread.IsValidIndex(PolicyIdx) || m_renderedStreams_RenderThread[PolicyIdx];
 }
 
 void FRenderStreamModule::OnPostEngineInit()
 {
+    FinishLoadingLibrary();
+
+    FRenderStreamStartupTimeline::FScope Stage(TEXT("Post engine init"));
     StreamPool = MakeUnique<FStreamPool>();
 
     const URenderStreamSettings* settings = GetDefault<URenderStreamSettings>();
@@ -323,14 +465,90 @@ void FRenderStreamModule::OnPostEngineInit()
         m_sceneSelector = std::make_unique<SceneSelector_Maps>();
         break;
 
+    case ERenderStreamSceneSelector::ResidentLevels:
+        UE_LOG(LogRenderStream, Log, TEXT("Using the 'resident streaming levels' scene selector"));
+        m_sceneSelector = std::make_unique<SceneSelector_ResidentLevels>(settings->ResidentSceneMemoryBudget);
+        break;
+
     default:
         UE_LOG(LogRenderStream, Error, TEXT("Unknown scene selector option %d - defaulting to none"), settings->SceneSelector);
         m_sceneSelector = std::make_unique<SceneSelector_None>();
     }
+
+    if (m_logDevice)
+    {
+        TMap<FName, ELogVerbosity::Type> CategoryVerbosity;
+        for (const auto& It : settings->LogForwardingCategoryVerbosity)
+            CategoryVerbosity.Add(It.Key, ELogVerbosity::Type(It.Value));
+        m_logDevice->SetVerbosity(ELogVerbosity::Type(settings->LogForwardingVerbosity), CategoryVerbosity);
+        m_logDevice->SetRateLimit(settings->LogForwardingRateLimit);
+    }
+
+    if (RenderStreamLink::instance().isAvailable())
+    {
+        float StallThresholds[uint8(ERenderStreamHeartbeat::Num)];
+        StallThresholds[uint8(ERenderStreamHeartbeat::Sync)] = settings->SyncStallThreshold;
+        StallThresholds[uint8(ERenderStreamHeartbeat::Send)] = settings->SendStallThreshold;
+        StallThresholds[uint8(ERenderStreamHeartbeat::GameThread)] = settings->GameThreadStallThreshold;
+        RenderStreamWatchdog().Open(StallThresholds, settings->bRecreateStalledStreams);
+
+        if (settings->bBalanceStreams && IDisplayCluster::IsAvailable() && IDisplayCluster::Get().GetOperationMode() == EDisplayClusterOperationMode::Cluster)
+        {
+            UE_LOG(LogRenderStream, Log, TEXT("Balancing streams across the cluster every %.0f s"), settings->StreamBalanceInterval);
+            m_scheduler.Open(settings->StreamBalanceInterval, settings->StreamBalanceThreshold);
+        }
+
+        if (IDisplayCluster::IsAvailable() && IDisplayCluster::Get().GetOperationMode() == EDisplayClusterOperationMode::Cluster)
+            m_clusterTimings.Open();
+
+        // Followers apply the controller's DMX values with the frame data, see FRenderStreamDmxReceiver.
+        IDisplayClusterClusterManager* ClusterMgr = IDisplayCluster::IsAvailable() ? IDisplayCluster::Get().GetClusterMgr() : nullptr;
+        if (settings->DmxPort > 0 && (!ClusterMgr || !ClusterMgr->IsSlave()))
+            RenderStreamDmxReceiver().Open(settings->DmxPort, settings->DmxFirstUniverse, settings->DmxUniverses);
+    }
+
+    WarmUp();
+}
+
+void FRenderStreamModule::WarmUp()
+{
+    if (!FApp::CanEverRender())
+        return;
+
+    {
+        FRenderStreamStartupTimeline::FScope Stage(TEXT("Stream discovery"));
+        if (!PopulateStreamPool())
+            return;
+    }
+
+    FRenderStreamStartupTimeline::FScope Stage(TEXT("Stream warm-up"));
+    // d3 is shown a warm-up status and is not waited on for frames until this returns.
+    RenderStreamMonitor().SetStatus(ERenderStreamStatusSource::WarmUp, TEXT("Warming up"));
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<FFrameStream*> Streams;
+    for (const TSharedPtr<FFrameStream>& Stream : StreamPool->GetAllStreams())
+        Streams.Add(Stream.Get());
+
+    ENQUEUE_RENDER_COMMAND(RenderStreamWarmUp)(
+        [Streams](FRHICommandListImmediate& RHICmdList)
+        {
+            for (FFrameStream* Stream : Streams)
+                Stream->WarmUp_RenderingThread(RHICmdList);
+            RHICmdList.SubmitCommandsAndFlushGPU();
+        });
+    FlushRenderingCommands();
+
+    WarmUpTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    UE_LOG(LogRenderStream, Display, TEXT("Warmed up %d streams in %.1f ms"), Streams.Num(), WarmUpTime);
+    RenderStreamMonitor().ClearStatus(ERenderStreamStatusSource::WarmUp);
 }
 
 void FRenderStreamModule::OnBeginFrame()
 {
+    RenderStreamWatchdog().Enter(ERenderStreamHeartbeat::GameThread, TEXT("the game thread frame"));
+    RenderStreamMonitor().Poll();
+
     // UpdateSyncObject
     IDisplayClusterClusterManager* ClusterMgr = IDisplayCluster::IsAvailable() ? IDisplayCluster::Get().GetClusterMgr() : nullptr;
     const bool IsController = !ClusterMgr || !ClusterMgr->IsSlave();
@@ -366,6 +584,8 @@ void FRenderStreamModule::OnPostLoadMapWithWorld(UWorld* InWorld)
         check(ClusterMgr);
         // Manager is cleared on map load, so register here instead of on module load
         ClusterMgr->RegisterSyncObject(&m_syncFrame, EDisplayClusterSyncGroup::PreTick);
+        m_scheduler.RegisterListener();
+        m_clusterTimings.RegisterListener();
     }
 
     EnableStats();
@@ -401,44 +621,68 @@ float GetStatValue(const FComplexStatMessage& Message)
     return 0.f;
 }
 
-void ParseMessages(TArray<RenderStreamLink::ProfilingEntry>& Entries, TMap<FString, const char*>& MessageNames, const TArray<FComplexStatMessage>& Messages)
+// A stat forwarded to d3. The short name is only parsed while searching for the stat, once found the
+// cached location is checked against the raw name each frame, which is a cheap FName comparison. An unresolved
+// stat is searched for each frame, it may be registered later in a group which is already active.
+struct FForwardedStat
 {
-    if (MessageNames.Num() != 0)
+    const char* Name;
+    bool IsCounter;
+
+    FName ShortName = NAME_None;
+    FName RawName = NAME_None;
+    int32 GroupIdx = INDEX_NONE;
+    int32 MessageIdx = INDEX_NONE;
+
+    const FComplexStatMessage* Resolve(const TArray<FActiveStatGroupInfo>& Groups)
     {
-        for (const FComplexStatMessage& Message : Messages)
+        if (Groups.IsValidIndex(GroupIdx))
+        {
+            const TArray<FComplexStatMessage>& Messages = IsCounter ? Groups[GroupIdx].CountersAggregate : Groups[GroupIdx].FlatAggregate;
+            if (Messages.IsValidIndex(MessageIdx) && Messages[MessageIdx].NameAndInfo.GetRawName() == RawName)
+                return &Messages[MessageIdx];
+        }
+
+        if (ShortName.IsNone())
+            ShortName = FName(Name);
+
+        for (int32 i = 0; i < Groups.Num(); ++i)
         {
-            FString Name = Message.GetShortName().ToString();
-            const char** Entry = MessageNames.Find(Name);
-            if (Entry)
+            const TArray<FComplexStatMessage>& Messages = IsCounter ? Groups[i].CountersAggregate : Groups[i].FlatAggregate;
+            for (int32 j = 0; j < Messages.Num(); ++j)
             {
-                Entries.Push({ *Entry, GetStatValue(Message) });
-                MessageNames.Remove(Name);
+                if (Messages[j].GetShortName() == ShortName)
+                {
+                    RawName = Messages[j].NameAndInfo.GetRawName();
+                    GroupIdx = i;
+                    MessageIdx = j;
+                    return &Messages[j];
+                }
             }
-
-            if (MessageNames.Num() == 0)
-                break;
         }
+
+        GroupIdx = INDEX_NONE;
+        MessageIdx = INDEX_NONE;
+        return nullptr;
     }
-}
+};
+
+FForwardedStat ForwardedStats[] = {
+    { FStat_STAT_AwaitFrame::GetStatName(), false },
+    { FStat_STAT_ReceiveFrame::GetStatName(), false },
+    // This is giving weird values, requires more investigation.
+    //{ FStat_STAT_RHITriangles::GetStatName(), true },
+};
 
 void FetchStats(TArray<RenderStreamLink::ProfilingEntry>& Entries)
 {
     FGameThreadStatsData* StatsData = FLatestGameThreadStatsData::Get().Latest;
     if (StatsData)
     {
-        TMap<FString, const char*> FlatStats = {
-            {FStat_STAT_AwaitFrame::GetStatName(), FStat_STAT_AwaitFrame::GetStatName()},
-            {FStat_STAT_ReceiveFrame::GetStatName(), FStat_STAT_ReceiveFrame::GetStatName()}
-        };
-        TMap<FString, const char*> CounterStats = {
-            // This is giving weird values, requires more investigation.
-            //{FStat_STAT_RHITriangles::GetStatName(), FStat_STAT_RHITriangles::GetStatName()}
-        };
-
-        for (const FActiveStatGroupInfo& Group : StatsData->ActiveStatGroups)
+        for (FForwardedStat& Stat : ForwardedStats)
         {
-            ParseMessages(Entries, FlatStats, Group.FlatAggregate);
-            ParseMessages(Entries, CounterStats, Group.CountersAggregate);
+            if (const FComplexStatMessage* Message = Stat.Resolve(StatsData->ActiveStatGroups))
+                Entries.Push({ Stat.Name, GetStatValue(*Message) });
         }
     }
 }
@@ -454,7 +698,9 @@ void FRenderStreamModule::EnableStats() const
 
 void FRenderStreamModule::OnEndFrame()
 {
-    TArray<RenderStreamLink::ProfilingEntry> Entries;
+    // Reused every frame to avoid reallocating the entries.
+    TArray<RenderStreamLink::ProfilingEntry>& Entries = m_profilingEntries;
+    Entries.Reset();
 #if STATS
     FetchStats(Entries);
 #endif
@@ -488,7 +734,67 @@ void FRenderStreamModule::OnEndFrame()
     Entries.Push({ "Render Time", FPlatformTime::ToMilliseconds(GRenderThreadTime) });
     Entries.Push({ "RHI Time", FPlatformTime::ToMilliseconds(GRHIThreadTime) });
     Entries.Push({ "GPU Time", gpuTime });
+    const int32 CopyGPUTimeEntry = Entries.Push({ "RS Copy GPU ms", 0.f });
     Entries.Push({ "Unreal Idle Time", FPlatformTime::ToMilliseconds(WaitTime) });
+    Entries.Push({ "Skipped Views", (float)m_skippedViews });
+    Entries.Push({ "Scene Apply Time", (float)SceneApplyTime });
+    Entries.Push({ "Parameter Apply Time", (float)ParameterApplyTime });
+    Entries.Push({ "Camera Apply Time", (float)CameraApplyTime });
+    Entries.Push({ "Warm-up Time", (float)WarmUpTime });
+
+    // Only the writes into the trace are timed, the work between them is not part of the recording cost.
+    uint64 TraceCycles = 0;
+    FRenderStreamTraceFrame* TraceFrame = nullptr;
+    if (m_trace)
+    {
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        TraceFrame = &m_trace->BeginRecord();
+        TraceFrame->Timestamp = FPlatformTime::Seconds();
+        TraceFrame->TrackedTime = m_syncFrame.m_frameData.tTracked;
+        TraceFrame->FrameNumber = GFrameCounter;
+        TraceFrame->FrameTime = DiffTime * 1000.0f;
+        TraceFrame->GameTime = FPlatformTime::ToMilliseconds(GGameThreadTime);
+        TraceFrame->RenderTime = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+        TraceFrame->RHITime = FPlatformTime::ToMilliseconds(GRHIThreadTime);
+        TraceFrame->GPUTime = gpuTime;
+        TraceFrame->SceneApplyTime = SceneApplyTime;
+        TraceFrame->ParameterApplyTime = ParameterApplyTime;
+        TraceFrame->CameraApplyTime = CameraApplyTime;
+        TraceCycles += FPlatformTime::Cycles64() - StartCycles;
+    }
+
+    float TotalSendTime = 0.f;
+    if (ProjectionPolicyFactory)
+    {
+        for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : ProjectionPolicyFactory->GetPolicies())
+        {
+            const TSharedPtr<FFrameStream>& Stream = Policy->GetStream();
+            if (!Stream)
+                continue;
+
+            TotalSendTime += Stream->SendTime();
+
+            Entries.Push({ Policy->GetFrameRateStatName(), Policy->GetRealisedFrameRate() });
+            Entries.Push({ Policy->GetQueueDepthStatName(), (float)Policy->GetQueueDepth() });
+            Entries.Push({ Stream->CopyTimeStatName(), Stream->CopyTime() });
+            Entries.Push({ Stream->SendTimeStatName(), Stream->SendTime() });
+            Entries.Push({ Stream->CopyGPUTimeStatName(), Stream->CopyGPUTime() });
+
+            // Streams which were not rendered this frame did not copy.
+            const bool Rendered = Policy->HasRenderedFrame() && m_renderedStreams.IsValidIndex(Policy->GetPolicyIndex()) && m_renderedStreams[Policy->GetPolicyIndex()];
+            if (Rendered)
+                Entries[CopyGPUTimeEntry].value += Stream->CopyGPUTime();
+
+            const int32 TraceIdx = Policy->GetPolicyIndex();
+            if (TraceFrame && TraceIdx < FRenderStreamTraceFrame::MaxStreams)
+            {
+                const uint64 StartCycles = FPlatformTime::Cycles64();
+                TraceFrame->Streams[TraceIdx] = { Stream->CopyTime(), Stream->SendTime(), Stream->CopyGPUTime(), Rendered };
+                TraceFrame->NumStreams = FMath::Max<uint32>(TraceFrame->NumStreams, TraceIdx + 1);
+                TraceCycles += FPlatformTime::Cycles64() - StartCycles;
+            }
+        }
+    }
 
     // Because their stats api is weird for now we are manually timing this.
     IDisplayClusterClusterManager* ClusterMgr = IDisplayCluster::IsAvailable() ? IDisplayCluster::Get().GetClusterMgr() : nullptr;
@@ -498,9 +804,265 @@ void FRenderStreamModule::OnEndFrame()
     else
         Entries.Push({ "Receive Time", (float)m_syncFrame.ReceiveTime });
 
+    if (m_logDevice)
+        Entries.Push({ "Log Messages Dropped", (float)m_logDevice->DroppedMessages() });
+
+    if (RenderStreamDmxReceiver().IsOpen())
+        RenderStreamDmxReceiver().AddProfilingEntries(Entries);
+
+    {
+        // The same totals as rs.memreport, at a rate which keeps walking the objects of cameras and scenes cheap.
+        const double Now = FPlatformTime::Seconds();
+        if (Now - m_memoryFeedTime >= MemoryFeedInterval)
+        {
+            m_memoryFeed = GatherMemoryUsage(true);
+            m_memoryFeedTime = Now;
+        }
+        Entries.Push({ "RS CPU Memory MB", float(m_memoryFeed.TotalCPU() / (1024.0 * 1024.0)) });
+        Entries.Push({ "RS GPU Memory MB", float(m_memoryFeed.TotalGPU() / (1024.0 * 1024.0)) });
+    }
+
+    if (m_scheduler.IsOpen() && ProjectionPolicyFactory && StreamPool)
+    {
+        m_scheduler.Tick(ProjectionPolicyFactory->GetPolicies(), *StreamPool, gpuTime, m_syncFrame.m_assignment);
+        if (IsController)
+            m_scheduler.AddProfilingEntries(Entries);
+    }
+
+    if (m_clusterTimings.IsOpen())
+    {
+        FRenderStreamNodeTiming Timing;
+        Timing.TrackedTime = m_syncFrame.m_frameData.tTracked;
+        Timing.ReceiveTime = float(IsController ? m_syncFrame.AwaitTime : m_syncFrame.ReceiveTime);
+        Timing.GameTime = FPlatformTime::ToMilliseconds(GGameThreadTime);
+        Timing.RenderTime = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+        Timing.GPUTime = gpuTime;
+        Timing.SendTime = TotalSendTime;
+        m_clusterTimings.Record(Timing);
+        if (IsController)
+            m_clusterTimings.AddProfilingEntries(Entries);
+    }
+
+    if (TraceFrame)
+    {
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        if (IsController)
+            TraceFrame->AwaitTime = m_syncFrame.AwaitTime;
+        else
+            TraceFrame->ReceiveTime = m_syncFrame.ReceiveTime;
+        m_trace->EndRecord(StartCycles, TraceCycles);
+        Entries.Push({ "Trace Record Time", m_trace->LastRecordTime() });
+    }
+
+    if (m_telemetry.IsOpen())
+        PublishTelemetry(DiffTime * 1000.0f, IsController);
+
+    RenderStreamWatchdog().Leave(ERenderStreamHeartbeat::GameThread);
+
     RenderStreamLink::instance().rs_sendProfilingData(Entries.GetData(), Entries.Num());
 }
 
+void FRenderStreamModule::PublishTelemetry(float FrameTime, bool IsController)
+{
+    // Parameter updates are counted over about a second, the rate holds its last value in between.
+    const double Now = FPlatformTime::Seconds();
+    const uint64 ParameterUpdates = m_sceneSelector ? m_sceneSelector->ParameterUpdates() : 0;
+    if (ParameterUpdates < m_telemetryParameterUpdates || m_telemetryRateStartTime == 0)
+    {
+        m_telemetryParameterUpdates = ParameterUpdates;
+        m_telemetryRateStartTime = Now;
+    }
+    float ParameterUpdateRate = -1.f;
+    if (Now - m_telemetryRateStartTime >= 1.0)
+    {
+        ParameterUpdateRate = float((ParameterUpdates - m_telemetryParameterUpdates) / (Now - m_telemetryRateStartTime));
+        m_telemetryParameterUpdates = ParameterUpdates;
+        m_telemetryRateStartTime = Now;
+    }
+    const FString Status = RenderStreamMonitor().GetStatus();
+
+    FRenderStreamTelemetryPage::FData& Data = m_telemetry.BeginWrite();
+    Data.FrameNumber = GFrameCounter;
+    Data.Timestamp = Now;
+    Data.TrackedTime = m_syncFrame.m_frameData.tTracked;
+    Data.FrameTime = FrameTime;
+    Data.AwaitTime = IsController ? m_syncFrame.AwaitTime : 0.f;
+    Data.ReceiveTime = IsController ? 0.f : m_syncFrame.ReceiveTime;
+    if (ParameterUpdateRate >= 0.f)
+        Data.ParameterUpdateRate = ParameterUpdateRate;
+    Data.ParameterApplyTime = ParameterApplyTime;
+    Data.Scene = m_syncFrame.m_frameData.scene;
+    RenderStreamTelemetryCopy(Data.SceneName, m_sceneSelector ? m_sceneSelector->SceneName(Data.Scene) : nullptr);
+    RenderStreamTelemetryCopy(Data.Status, TCHAR_TO_UTF8(*Status));
+
+    uint32 NumStreams = 0;
+    if (ProjectionPolicyFactory)
+    {
+        for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : ProjectionPolicyFactory->GetPolicies())
+        {
+            const TSharedPtr<FFrameStream>& Stream = Policy->GetStream();
+            const int32 Idx = Policy->GetPolicyIndex();
+            if (!Stream || Idx >= FRenderStreamTelemetryPage::MaxStreams)
+                continue;
+
+            FRenderStreamTelemetryPage::FStream& Out = Data.Streams[Idx];
+            // The counters belong to the stream, start them again when another stream takes the slot.
+            const FTCHARToUTF8 Name(*Stream->Name());
+            if (FCStringAnsi::Strncmp(Out.Name, Name.Get(), FRenderStreamTelemetryPage::MaxName - 1) != 0)
+            {
+                FMemory::Memzero(Out);
+                RenderStreamTelemetryCopy(Out.Name, Name.Get());
+            }
+
+            const bool Requested = m_requestedStreams.IsValidIndex(Idx) && m_requestedStreams[Idx];
+            const bool Rendered = Policy->HasRenderedFrame() && m_renderedStreams.IsValidIndex(Idx) && m_renderedStreams[Idx];
+            if (Requested)
+            {
+                ++Out.FramesSent;
+                if (!Rendered)
+                    ++Out.FramesDropped;
+            }
+            Out.QueueDepth = Policy->GetQueueDepth();
+            Out.FrameRate = Policy->GetRealisedFrameRate();
+            Out.CopyTime = Stream->CopyTime();
+            Out.SendTime = Stream->SendTime();
+            Out.CopyGPUTime = Stream->CopyGPUTime();
+            Out.LatencyMs = Out.QueueDepth * FrameTime + Out.CopyTime + Out.SendTime;
+            NumStreams = FMath::Max<uint32>(NumStreams, Idx + 1);
+        }
+    }
+    Data.NumStreams = NumStreams;
+    m_telemetry.EndWrite();
+}
+
+void FRenderStreamModule::DumpTrace(const FString& Path) const
+{
+    // Trace records index streams by projection policy.
+    TArray<FString> StreamNames;
+    if (ProjectionPolicyFactory)
+    {
+        for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : ProjectionPolicyFactory->GetPolicies())
+        {
+            const TSharedPtr<FFrameStream>& Stream = Policy->GetStream();
+            StreamNames.Add(Stream ? Stream->Name() : Policy->GetViewportId());
+        }
+    }
+    m_trace->Dump(Path, StreamNames);
+}
+
+// The persistent level or the loaded streaming level a scene is named after, null when it is not loaded.
+static ULevel* FindSceneLevel(const UWorld& World, const FString& SceneName)
+{
+    if (World.GetName() == SceneName)
+        return World.PersistentLevel;
+
+    for (ULevelStreaming* StreamingLevel : World.GetStreamingLevels())
+    {
+        FString LevelName = FPackageName::GetShortName(StreamingLevel->GetWorldAssetPackageName());
+        LevelName.RemoveFromStart(World.StreamingLevelsPrefix);
+        if (LevelName == SceneName)
+            return StreamingLevel->GetLoadedLevel();
+    }
+    return nullptr;
+}
+
+// Resource sizes of an object and everything in it. Textures report their video memory as dedicated, the rest is CPU.
+static void EstimateObjectMemory(UObject* Outer, uint64& OutCPU, uint64& OutGPU)
+{
+    FResourceSizeEx Size(EResourceSizeMode::Exclusive);
+    Outer->GetResourceSizeEx(Size);
+    ForEachObjectWithOuter(Outer, [&Size](UObject* Object) { Object->GetResourceSizeEx(Size); }, true);
+    OutGPU += Size.GetDedicatedVideoMemoryBytes();
+    OutCPU += Size.GetTotalMemoryBytes() - Size.GetDedicatedVideoMemoryBytes();
+}
+
+FRenderStreamMemoryUsage FRenderStreamModule::GatherMemoryUsage(bool bEstimateObjects) const
+{
+    FRenderStreamMemoryUsage Usage;
+    uint64* CPU = Usage.CPU;
+
+    if (StreamPool)
+    {
+        for (const TSharedPtr<FFrameStream>& Stream : StreamPool->GetAllStreams())
+        {
+            CPU[uint8(ERenderStreamMemory::Streams)] += Stream->CPUMemory();
+            Usage.GPU[uint8(ERenderStreamMemory::Streams)] += Stream->GPUMemory();
+        }
+    }
+
+    if (m_sceneSelector)
+        CPU[uint8(ERenderStreamMemory::Schema)] += m_sceneSelector->SchemaMemory();
+
+    if (ProjectionPolicyFactory)
+    {
+        for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : ProjectionPolicyFactory->GetPolicies())
+        {
+            CPU[uint8(ERenderStreamMemory::Responses)] += Policy->GetQueueMemory();
+            if (bEstimateObjects && Policy->GetCamera())
+                EstimateObjectMemory(const_cast<ACameraActor*>(Policy->GetCamera()), CPU[uint8(ERenderStreamMemory::Cameras)], Usage.GPU[uint8(ERenderStreamMemory::Cameras)]);
+        }
+    }
+
+    if (bEstimateObjects && m_World && m_sceneSelector)
+    {
+        // Scenes can share a level, the persistent level in particular.
+        TSet<ULevel*> Levels;
+        for (uint32_t i = 0; i < m_sceneSelector->NumScenes(); ++i)
+        {
+            if (ULevel* Level = FindSceneLevel(*m_World, UTF8_TO_TCHAR(m_sceneSelector->SceneName(i))))
+                Levels.Add(Level);
+        }
+        for (ULevel* Level : Levels)
+            EstimateObjectMemory(Level, CPU[uint8(ERenderStreamMemory::Scenes)], Usage.GPU[uint8(ERenderStreamMemory::Scenes)]);
+    }
+
+    CPU[uint8(ERenderStreamMemory::Diagnostics)] += (m_trace ? m_trace->AllocatedSize() : 0) +
+        (m_telemetry.IsOpen() ? sizeof(FRenderStreamTelemetryPage) : 0) + RenderStreamDmxReceiver().AllocatedSize();
+    return Usage;
+}
+
+void FRenderStreamModule::MemReport() const
+{
+    check(IsInGameThread());
+    auto MB = [](uint64 Bytes) { return Bytes / (1024.0 * 1024.0); };
+
+    UE_LOG(LogRenderStream, Display, TEXT("RenderStream memory:"));
+
+    // A stream's CPU memory includes the responses queued by the policies bound to it.
+    const TArray<TSharedPtr<FRenderStreamProjectionPolicy>> Policies = ProjectionPolicyFactory ? ProjectionPolicyFactory->GetPolicies() : TArray<TSharedPtr<FRenderStreamProjectionPolicy>>();
+    for (const TSharedPtr<FFrameStream>& Stream : StreamPool->GetAllStreams())
+    {
+        uint64 CPU = Stream->CPUMemory();
+        for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : Policies)
+        {
+            if (Policy->GetStream() == Stream)
+                CPU += Policy->GetQueueMemory();
+        }
+        UE_LOG(LogRenderStream, Display, TEXT("  Stream %-24s %dx%d  CPU %8.3f MB  GPU %8.3f MB"), *Stream->Name(), Stream->Resolution().X, Stream->Resolution().Y, MB(CPU), MB(Stream->GPUMemory()));
+    }
+
+    if (m_World && m_sceneSelector)
+    {
+        for (uint32_t i = 0; i < m_sceneSelector->NumScenes(); ++i)
+        {
+            const FString SceneName = UTF8_TO_TCHAR(m_sceneSelector->SceneName(i));
+            if (ULevel* Level = FindSceneLevel(*m_World, SceneName))
+            {
+                uint64 CPU = 0, GPU = 0;
+                EstimateObjectMemory(Level, CPU, GPU);
+                UE_LOG(LogRenderStream, Display, TEXT("  Scene  %-24s resident  CPU %8.3f MB  GPU %8.3f MB"), *SceneName, MB(CPU), MB(GPU));
+            }
+            else
+                UE_LOG(LogRenderStream, Display, TEXT("  Scene  %-24s not loaded"), *SceneName);
+        }
+    }
+
+    const FRenderStreamMemoryUsage Usage = GatherMemoryUsage(true);
+    for (uint8 i = 0; i < uint8(ERenderStreamMemory::Num); ++i)
+        UE_LOG(LogRenderStream, Display, TEXT("  %-31s CPU %8.3f MB  GPU %8.3f MB"), RenderStreamMemoryName(ERenderStreamMemory(i)), MB(Usage.CPU[i]), MB(Usage.GPU[i]));
+    UE_LOG(LogRenderStream, Display, TEXT("  %-31s CPU %8.3f MB  GPU %8.3f MB"), TEXT("Total"), MB(Usage.TotalCPU()), MB(Usage.TotalGPU()));
+}
+
 /*static*/ FRenderStreamModule* FRenderStreamModule::Get()
 {
     return &FModuleManager::GetModuleChecked<FRenderStreamModule>("RenderStream");
@@ -4,6 +4,7 @@
 
 #include "Core.h"
 #include "Core/Public/Modules/ModuleInterface.h"
+#include "Async/Future.h"
 #include "Cluster/IDisplayClusterClusterManager.h"
 #include <set>
 #include <memory>
@@ -13,6 +14,10 @@
 #include "RenderStreamLink.h"
 #include "StreamPool.h"
 #include "SyncFrameData.h"
+#include "RenderStreamClusterTimings.h"
+#include "RenderStreamMemory.h"
+#include "RenderStreamTelemetry.h"
+#include "RenderStreamTrace.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogRenderStream, Log, All);
 
@@ -20,6 +25,7 @@ class UCameraComponent;
 class AActor;
 class RenderStreamSceneSelector;
 class FRenderStreamProjectionPolicyFactory;
+class FRenderStreamSchemaIndex;
 
 class FRenderStreamModule : public IModuleInterface
 {
@@ -38,8 +44,19 @@ protected:
 
     void EnableStats() const;
 
+    // Waits for the library loaded in the background by StartupModule and completes startup once it is ready.
+    // Idempotent, false when the library is unavailable.
+    bool FinishLoadingLibrary();
+    // The index prefetched by StartupModule, or opened now when there is none.
+    TSharedPtr<FRenderStreamSchemaIndex> TakeSchemaIndex();
+
+    TFuture<TOptional<RenderStreamLink::RS_ERROR>> m_libraryLoad;
+    TFuture<TSharedPtr<FRenderStreamSchemaIndex>> m_schemaIndexLoad;
+
 public:
     bool PopulateStreamPool();
+    // Create every stream and its copy PSO up front, so the first frames d3 requests don't pay for it.
+    void WarmUp();
 
     static FRenderStreamModule* Get();
     
@@ -52,6 +69,21 @@ public:
 
     void ApplyCameras(const RenderStreamLink::FrameData& frameData);
 
+    // The stream the viewport renders, its own name unless the cluster scheduler assigned another.
+    FString GetAssignedStream(const FString& ViewportId) const;
+    // Rebinds the local policies whose stream changed, on the same frame on every node.
+    void ApplyStreamAssignment(const FRenderStreamAssignment& Assignment);
+    FRenderStreamClusterScheduler m_scheduler;
+    FRenderStreamClusterTimings m_clusterTimings;
+
+    // Render-on-demand masks, one bit per policy (and so per view family). Streams d3 did not request
+    // this frame are neither rendered nor copied, requested streams skipped by their frame-rate divisor
+    // re-send their last frame. The render thread copies are updated in step via a render command.
+    bool IsStreamRequested(int32 PolicyIdx) const;
+    bool IsStreamRendered(int32 PolicyIdx) const;
+    bool IsStreamRequested_RenderThread(int32 PolicyIdx) const;
+    bool IsStreamRendered_RenderThread(int32 PolicyIdx) const;
+
     void OnModulesChanged(FName ModuleName, EModuleChangeReason ReasonForChange);
     void OnPostLoadMapWithWorld(UWorld* InWorld);
 
@@ -59,4 +91,37 @@ public:
     TSharedPtr<FRenderStreamLogOutputDevice, ESPMode::ThreadSafe> m_logDevice = nullptr;
     const UWorld* m_World; // temporary - needs to be held by Scene Selector.
     double m_LastTime = 0;
+
+    TBitArray<> m_requestedStreams;
+    TBitArray<> m_renderedStreams;
+    TBitArray<> m_requestedStreams_RenderThread;
+    TBitArray<> m_renderedStreams_RenderThread;
+    int32 m_skippedViews = 0;
+
+    // Timings of the last applied frame, in milliseconds.
+    double SceneApplyTime = 0;
+    double ParameterApplyTime = 0;
+    double CameraApplyTime = 0;
+    double WarmUpTime = 0;
+
+    TArray<RenderStreamLink::ProfilingEntry> m_profilingEntries;
+
+    // Last two minutes at 60Hz of per-frame timings, see rs.trace.dump.
+    static constexpr int32 TraceFrames = 2 * 60 * 60;
+    TUniquePtr<FRenderStreamTrace> m_trace;
+    void DumpTrace(const FString& Path) const;
+
+    // Published once per frame for monitoring outside the process, see RenderStreamTelemetry.h.
+    FRenderStreamTelemetry m_telemetry;
+    uint64 m_telemetryParameterUpdates = 0;
+    double m_telemetryRateStartTime = 0;
+    void PublishTelemetry(float FrameTime, bool IsController);
+
+    // Memory per category, see RenderStreamMemory.h. Estimating cameras and scenes walks their objects, so the
+    // profiling feed gathers the full totals once a second and pushes the cached ones in between.
+    FRenderStreamMemoryUsage GatherMemoryUsage(bool bEstimateObjects) const;
+    void MemReport() const;
+    static constexpr double MemoryFeedInterval = 1.0;
+    FRenderStreamMemoryUsage m_memoryFeed;
+    double m_memoryFeedTime = 0;
 };
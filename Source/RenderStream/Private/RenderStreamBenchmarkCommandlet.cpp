@@ -0,0 +1,290 @@
+#include "RenderStreamBenchmarkCommandlet.h"
+
+#include "RenderStream.h"
+#include "RenderStreamBenchmarkStats.h"
+#include "RenderStreamFakeBackend.h"
+#include "RenderStreamProjectionPolicy.h"
+#include "SceneSelector_None.h"
+#include "FrameStream.h"
+
+#include "Engine/World.h"
+#include "HardwareInfo.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "RenderingThread.h"
+#include "Serialization/JsonSerializer.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRenderStreamBenchmark, Log, All);
+
+using namespace RenderStreamBenchmark;
+
+namespace {
+    const TCHAR* FormatName(RenderStreamLink::RSPixelFormat Format)
+    {
+        switch (Format)
+        {
+        case RenderStreamLink::RS_FMT_BGRA8: return TEXT("BGRA8");
+        case RenderStreamLink::RS_FMT_BGRX8: return TEXT("BGRX8");
+        case RenderStreamLink::RS_FMT_RGBA32F: return TEXT("RGBA32F");
+        default: return TEXT("Invalid");
+        }
+    }
+
+    // Stage times below this are dominated by noise and never flagged.
+    static constexpr double RegressionFloorMs = 0.05;
+
+    // Compares against a previous run's output, logs and counts every value which got worse by more than Tolerance.
+    int32 CompareWithBaseline(const FJsonObject& Results, const FJsonObject& Baseline, double Tolerance)
+    {
+        int32 Regressions = 0;
+
+        const double Fps = Results.GetNumberField(TEXT("FramesPerSecond"));
+        const double BaselineFps = Baseline.GetNumberField(TEXT("FramesPerSecond"));
+        if (Fps < BaselineFps * (1.0 - Tolerance))
+        {
+            UE_LOG(LogRenderStreamBenchmark, Error, TEXT("Regression: %.1f frames/s against a baseline of %.1f frames/s"), Fps, BaselineFps);
+            ++Regressions;
+        }
+
+        auto CompareSummary = [&Regressions, Tolerance](const FString& Name, const TSharedPtr<FJsonObject>& Summary, const TSharedPtr<FJsonObject>& BaselineSummary)
+        {
+            if (!Summary || !BaselineSummary)
+                return;
+            for (const TCHAR* Field : { TEXT("P50"), TEXT("P99") })
+            {
+                const double Value = Summary->GetNumberField(Field);
+                const double BaselineValue = BaselineSummary->GetNumberField(Field);
+                if (Value > RegressionFloorMs && Value > BaselineValue * (1.0 + Tolerance))
+                {
+                    UE_LOG(LogRenderStreamBenchmark, Error, TEXT("Regression: %s %s %.3fms against a baseline of %.3fms"), *Name, Field, Value, BaselineValue);
+                    ++Regressions;
+                }
+            }
+        };
+
+        const TSharedPtr<FJsonObject>* Stages = nullptr;
+        const TSharedPtr<FJsonObject>* BaselineStages = nullptr;
+        if (Results.TryGetObjectField(TEXT("Stages"), Stages) && Baseline.TryGetObjectField(TEXT("Stages"), BaselineStages))
+        {
+            for (const auto& Stage : (*Stages)->Values)
+            {
+                const TSharedPtr<FJsonObject>* BaselineStage = nullptr;
+                if ((*BaselineStages)->TryGetObjectField(Stage.Key, BaselineStage))
+                    CompareSummary(Stage.Key, Stage.Value->AsObject(), *BaselineStage);
+            }
+        }
+
+        const TSharedPtr<FJsonObject>* Latency = nullptr;
+        const TSharedPtr<FJsonObject>* BaselineLatency = nullptr;
+        if (Results.TryGetObjectField(TEXT("Latency"), Latency) && Baseline.TryGetObjectField(TEXT("Latency"), BaselineLatency))
+            CompareSummary(TEXT("Latency"), *Latency, *BaselineLatency);
+
+        return Regressions;
+    }
+}
+
+URenderStreamBenchmarkCommandlet::URenderStreamBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 URenderStreamBenchmarkCommandlet::Main(const FString& Params)
+{
+    RenderStreamFakeBackend::FConfig Config;
+    FParse::Value(*Params, TEXT("Streams="), Config.NumStreams);
+    FParse::Value(*Params, TEXT("Width="), Config.Resolution.X);
+    FParse::Value(*Params, TEXT("Height="), Config.Resolution.Y);
+    FString Format;
+    if (FParse::Value(*Params, TEXT("Format="), Format))
+    {
+        Config.Format = Format == TEXT("BGRX8") ? RenderStreamLink::RS_FMT_BGRX8
+                      : Format == TEXT("RGBA32F") ? RenderStreamLink::RS_FMT_RGBA32F
+                      : RenderStreamLink::RS_FMT_BGRA8;
+    }
+    int32 NumFrames = 600;
+    int32 NumWarmupFrames = 60;
+    FParse::Value(*Params, TEXT("Frames="), NumFrames);
+    FParse::Value(*Params, TEXT("Warmup="), NumWarmupFrames);
+    FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RenderStream"), TEXT("Benchmark.json"));
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    FString BaselinePath;
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+    float Tolerance = 0.1f;
+    FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+    const FString RHIName = FHardwareInfo::GetHardwareInfo(NAME_RHI);
+    if (RHIName != TEXT("D3D11") && RHIName != TEXT("D3D12"))
+    {
+        UE_LOG(LogRenderStreamBenchmark, Error, TEXT("The benchmark needs a D3D11 or D3D12 RHI, got '%s' - run with -AllowCommandletRendering"), *RHIName);
+        return 1;
+    }
+    if (Config.NumStreams < 1 || Config.Resolution.X < 1 || Config.Resolution.Y < 1 || NumFrames < 1)
+    {
+        UE_LOG(LogRenderStreamBenchmark, Error, TEXT("Invalid benchmark configuration"));
+        return 1;
+    }
+
+    RenderStreamFakeBackend::Configure(Config);
+    if (!RenderStreamLink::instance().loadFake())
+    {
+        UE_LOG(LogRenderStreamBenchmark, Error, TEXT("Unable to load the fake RenderStream backend"));
+        return 1;
+    }
+
+    // Stand in for what OnPostEngineInit, nDisplay and StartScene normally set up on the module and its policies.
+    FRenderStreamModule* Module = FRenderStreamModule::Get();
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("RenderStreamBenchmark"));
+    Module->StreamPool = MakeUnique<FStreamPool>();
+    Module->m_sceneSelector = std::make_unique<SceneSelector_None>();
+    Module->LoadSchemas(*World);
+
+    const TSharedPtr<FRenderStreamProjectionPolicyFactory> PreviousFactory = Module->ProjectionPolicyFactory;
+    Module->ProjectionPolicyFactory = MakeShared<FRenderStreamProjectionPolicyFactory>();
+    ON_SCOPE_EXIT
+    {
+        Module->ProjectionPolicyFactory = PreviousFactory;
+        Module->StreamPool.Reset();
+        World->DestroyWorld(false);
+        RenderStreamLink::instance().unloadExplicit();
+    };
+
+    if (!Module->PopulateStreamPool() || Module->StreamPool->StreamCount() != uint32_t(Config.NumStreams))
+    {
+        UE_LOG(LogRenderStreamBenchmark, Error, TEXT("Unable to create %d %dx%d %s streams"), Config.NumStreams, Config.Resolution.X, Config.Resolution.Y, FormatName(Config.Format));
+        return 1;
+    }
+
+    TArray<TSharedPtr<FRenderStreamProjectionPolicy>> Policies;
+    for (int32 i = 0; i < Config.NumStreams; ++i)
+    {
+        const FString Name = FString::Printf(TEXT("Benchmark%d"), i);
+        Module->ProjectionPolicyFactory->Create(FRenderStreamProjectionPolicyFactory::RenderStreamPolicyType, RHIName, Name, {});
+        TSharedPtr<FRenderStreamProjectionPolicy> Policy = Module->ProjectionPolicyFactory->GetPolicyByViewport(Name);
+        Policy->BindStream(Module->StreamPool->GetStream(Name));
+        Policies.Add(Policy);
+    }
+
+    // The rendered view the streams copy from.
+    FTexture2DRHIRef SourceTexture;
+    ENQUEUE_RENDER_COMMAND(RenderStreamBenchmarkSource)(
+        [&SourceTexture, Resolution = Config.Resolution](FRHICommandListImmediate& RHICmdList)
+        {
+            FRHIResourceCreateInfo Info;
+            SourceTexture = RHICreateTexture2D(Resolution.X, Resolution.Y, PF_B8G8R8A8, 1, 1, TexCreate_RenderTargetable | TexCreate_ShaderResource, Info);
+        });
+    FlushRenderingCommands();
+
+    TArray<double> FrameTimes, ReceiveTimes, SceneTimes, CameraTimes, CopyTimes, SendTimes;
+    for (TArray<double>* Samples : { &FrameTimes, &ReceiveTimes, &SceneTimes, &CameraTimes, &CopyTimes, &SendTimes })
+        Samples->Reserve(NumFrames);
+
+    UE_LOG(LogRenderStreamBenchmark, Display, TEXT("Benchmarking %d %dx%d %s streams for %d frames after %d warm-up frames"),
+        Config.NumStreams, Config.Resolution.X, Config.Resolution.Y, FormatName(Config.Format), NumFrames, NumWarmupFrames);
+
+    double MeasureStart = FPlatformTime::Seconds();
+    for (int32 Frame = 0; Frame < NumWarmupFrames + NumFrames; ++Frame)
+    {
+        if (Frame == NumWarmupFrames)
+        {
+            RenderStreamFakeBackend::TakeSendLatencies();
+            MeasureStart = FPlatformTime::Seconds();
+        }
+
+        const double FrameStart = FPlatformTime::Seconds();
+
+        // Awaits, then applies the scene and the cameras.
+        Module->m_syncFrame.ControllerReceive();
+
+        // The nDisplay warp-blend call which copies and sends each view.
+        ENQUEUE_RENDER_COMMAND(RenderStreamBenchmarkSend)(
+            [&Policies, Source = SourceTexture, Rect = FIntRect(FIntPoint::ZeroValue, Config.Resolution)](FRHICommandListImmediate& RHICmdList)
+            {
+                for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : Policies)
+                    Policy->ApplyWarpBlend_RenderThread(0, RHICmdList, Source, Rect);
+            });
+        FlushRenderingCommands();
+
+        if (Frame < NumWarmupFrames)
+            continue;
+
+        double CopyTime = 0;
+        double SendTime = 0;
+        for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : Policies)
+        {
+            CopyTime += Policy->GetStream()->CopyTime();
+            SendTime += Policy->GetStream()->SendTime();
+        }
+
+        FrameTimes.Add((FPlatformTime::Seconds() - FrameStart) * 1000.0);
+        ReceiveTimes.Add(Module->m_syncFrame.AwaitTime - Module->SceneApplyTime - Module->CameraApplyTime);
+        SceneTimes.Add(Module->SceneApplyTime);
+        CameraTimes.Add(Module->CameraApplyTime);
+        CopyTimes.Add(CopyTime);
+        SendTimes.Add(SendTime);
+    }
+    const double Elapsed = FPlatformTime::Seconds() - MeasureStart;
+
+    TSharedRef<FJsonObject> Results = MakeShared<FJsonObject>();
+    {
+        TSharedRef<FJsonObject> JsonConfig = MakeShared<FJsonObject>();
+        JsonConfig->SetNumberField(TEXT("Streams"), Config.NumStreams);
+        JsonConfig->SetNumberField(TEXT("Width"), Config.Resolution.X);
+        JsonConfig->SetNumberField(TEXT("Height"), Config.Resolution.Y);
+        JsonConfig->SetStringField(TEXT("Format"), FormatName(Config.Format));
+        JsonConfig->SetStringField(TEXT("RHI"), RHIName);
+        JsonConfig->SetNumberField(TEXT("Frames"), NumFrames);
+        Results->SetObjectField(TEXT("Config"), JsonConfig);
+
+        Results->SetNumberField(TEXT("FramesPerSecond"), Elapsed > 0 ? NumFrames / Elapsed : 0);
+        Results->SetNumberField(TEXT("SentFrames"), double(RenderStreamFakeBackend::NumSentFrames()));
+
+        // Per-stage times in milliseconds, Copy and Send are summed over the streams.
+        TSharedRef<FJsonObject> Stages = MakeShared<FJsonObject>();
+        Stages->SetObjectField(TEXT("Frame"), ToJson(Summarise(FrameTimes)));
+        Stages->SetObjectField(TEXT("Receive"), ToJson(Summarise(ReceiveTimes)));
+        Stages->SetObjectField(TEXT("ApplyScene"), ToJson(Summarise(SceneTimes)));
+        Stages->SetObjectField(TEXT("ApplyCameras"), ToJson(Summarise(CameraTimes)));
+        Stages->SetObjectField(TEXT("Copy"), ToJson(Summarise(CopyTimes)));
+        Stages->SetObjectField(TEXT("Send"), ToJson(Summarise(SendTimes)));
+        Results->SetObjectField(TEXT("Stages"), Stages);
+
+        // From the frame being handed out to each of its streams being sent.
+        Results->SetObjectField(TEXT("Latency"), ToJson(Summarise(RenderStreamFakeBackend::TakeSendLatencies())));
+    }
+
+    FString Output;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+    FJsonSerializer::Serialize(Results, Writer);
+    if (!FFileHelper::SaveStringToFile(Output, *OutputPath))
+    {
+        UE_LOG(LogRenderStreamBenchmark, Error, TEXT("Unable to write the results to '%s'"), *OutputPath);
+        return 1;
+    }
+    UE_LOG(LogRenderStreamBenchmark, Display, TEXT("%.1f frames/s, results written to '%s'"), Results->GetNumberField(TEXT("FramesPerSecond")), *OutputPath);
+
+    if (!BaselinePath.IsEmpty())
+    {
+        FString BaselineString;
+        TSharedPtr<FJsonObject> Baseline;
+        if (!FFileHelper::LoadFileToString(BaselineString, *BaselinePath) ||
+            !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineString), Baseline) || !Baseline)
+        {
+            UE_LOG(LogRenderStreamBenchmark, Error, TEXT("Unable to read the baseline '%s'"), *BaselinePath);
+            return 1;
+        }
+
+        const int32 Regressions = CompareWithBaseline(*Results, *Baseline, Tolerance);
+        if (Regressions > 0)
+        {
+            UE_LOG(LogRenderStreamBenchmark, Error, TEXT("%d regressions against '%s'"), Regressions, *BaselinePath);
+            return 2;
+        }
+        UE_LOG(LogRenderStreamBenchmark, Display, TEXT("No regressions against '%s'"), *BaselinePath);
+    }
+
+    return 0;
+}
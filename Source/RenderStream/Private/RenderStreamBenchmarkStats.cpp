@@ -0,0 +1,43 @@
+#include "RenderStreamBenchmarkStats.h"
+
+RenderStreamBenchmark::FSummary RenderStreamBenchmark::Summarise(TArray<double> Samples)
+{
+    FSummary Summary;
+    Summary.Samples = Samples.Num();
+    if (Samples.Num() == 0)
+        return Summary;
+
+    Samples.Sort();
+    // nearest-rank percentiles
+    auto Percentile = [&Samples](double P) { return Samples[FMath::Clamp(FMath::CeilToInt(P * Samples.Num()) - 1, 0, Samples.Num() - 1)]; };
+    double Total = 0;
+    for (double Sample : Samples)
+        Total += Sample;
+    Summary.Mean = Total / Samples.Num();
+
+    double SquaredDeviations = 0;
+    for (double Sample : Samples)
+        SquaredDeviations += FMath::Square(Sample - Summary.Mean);
+    Summary.StdDev = Samples.Num() > 1 ? FMath::Sqrt(SquaredDeviations / (Samples.Num() - 1)) : 0;
+
+    Summary.Min = Samples[0];
+    Summary.P50 = Percentile(0.5);
+    Summary.P90 = Percentile(0.9);
+    Summary.P99 = Percentile(0.99);
+    Summary.Max = Samples.Last();
+    return Summary;
+}
+
+TSharedRef<FJsonObject> RenderStreamBenchmark::ToJson(const FSummary& Summary)
+{
+    TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("Samples"), Summary.Samples);
+    Json->SetNumberField(TEXT("Mean"), Summary.Mean);
+    Json->SetNumberField(TEXT("StdDev"), Summary.StdDev);
+    Json->SetNumberField(TEXT("Min"), Summary.Min);
+    Json->SetNumberField(TEXT("P50"), Summary.P50);
+    Json->SetNumberField(TEXT("P90"), Summary.P90);
+    Json->SetNumberField(TEXT("P99"), Summary.P99);
+    Json->SetNumberField(TEXT("Max"), Summary.Max);
+    return Json;
+}
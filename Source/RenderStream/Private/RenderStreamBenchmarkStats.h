@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+// Statistical summaries shared by the benchmark commandlets.
+namespace RenderStreamBenchmark
+{
+    struct FSummary
+    {
+        int32 Samples = 0;
+        double Mean = 0;
+        double StdDev = 0;
+        double Min = 0;
+        double P50 = 0;
+        double P90 = 0;
+        double P99 = 0;
+        double Max = 0;
+    };
+
+    FSummary Summarise(TArray<double> Samples);
+    TSharedRef<FJsonObject> ToJson(const FSummary& Summary);
+}
@@ -2,6 +2,7 @@
 
 #include "Camera/CameraActor.h"
 #include "Camera/CameraComponent.h"
+#include "Components/PrimitiveComponent.h"
 #include "Engine/GameEngine.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -111,6 +112,7 @@ TWeakObjectPtr<ACameraActor> URenderStreamChannelDefinition::GetChannelCamera(co
 
 URenderStreamChannelDefinition::URenderStreamChannelDefinition()
     : DefaultVisibility(EVisibilty::Visible)
+    , FrameRateDivisor(1)
     , ShowFlags(EShowFlagInitMode::ESFIM_Game)
     , Registered(false)
 {}
@@ -164,6 +166,21 @@ void URenderStreamChannelDefinition::UpdateShowFlags()
     }
 }
 
+void URenderStreamChannelDefinition::GetFilteredPrimitives(TSet<FPrimitiveComponentId>& OutPrimitives) const
+{
+    const TArray<TWeakObjectPtr<AActor>>& Actors = DefaultVisibility == EVisibilty::Visible ? Hidden : Visible;
+    for (const TWeakObjectPtr<AActor>& Actor : Actors)
+    {
+        if (Actor.IsValid())
+        {
+            Actor->ForEachComponent<UPrimitiveComponent>(false, [&OutPrimitives](const UPrimitiveComponent* PrimativeComponent)
+            {
+                OutPrimitives.Add(PrimativeComponent->ComponentId);
+            });
+        }
+    }
+}
+
 #if WITH_EDITOR
 void URenderStreamChannelDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
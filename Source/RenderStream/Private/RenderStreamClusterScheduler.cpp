@@ -0,0 +1,274 @@
+#include "RenderStreamClusterScheduler.h"
+
+#include "FrameStream.h"
+#include "RenderStream.h"
+#include "RenderStreamProjectionPolicy.h"
+#include "StreamPool.h"
+
+#include "IDisplayCluster.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Binary cluster event ids, distinct from any the project emits itself.
+static constexpr int32 CostEventId = 0x52530001;
+// Nodes report once a second, a report older than a few of those belongs to a node which stopped reporting.
+static constexpr double ReportInterval = 1.0;
+static constexpr double ReportTimeout = 5.0;
+
+namespace {
+    IDisplayClusterClusterManager* GetClusterManager()
+    {
+        return IDisplayCluster::IsAvailable() ? IDisplayCluster::Get().GetClusterMgr() : nullptr;
+    }
+}
+
+FRenderStreamClusterScheduler::~FRenderStreamClusterScheduler()
+{
+    Close();
+}
+
+void FRenderStreamClusterScheduler::Open(float InRebalanceInterval, float InRebalanceThreshold)
+{
+    m_rebalanceInterval = InRebalanceInterval;
+    m_rebalanceThreshold = InRebalanceThreshold;
+    m_lastRebalanceTime = FPlatformTime::Seconds();
+    m_listener = FOnClusterEventBinaryListener::CreateRaw(this, &FRenderStreamClusterScheduler::OnClusterEvent);
+    m_open = true;
+    RegisterListener();
+}
+
+void FRenderStreamClusterScheduler::Close()
+{
+    if (!m_open)
+        return;
+
+    if (IDisplayClusterClusterManager* ClusterMgr = GetClusterManager())
+        ClusterMgr->RemoveClusterEventBinaryListener(m_listener);
+    m_listener.Unbind();
+    m_nodes.Empty();
+    m_open = false;
+}
+
+void FRenderStreamClusterScheduler::RegisterListener()
+{
+    IDisplayClusterClusterManager* ClusterMgr = GetClusterManager();
+    if (!m_open || !ClusterMgr)
+        return;
+
+    ClusterMgr->RemoveClusterEventBinaryListener(m_listener);
+    ClusterMgr->AddClusterEventBinaryListener(m_listener);
+}
+
+void FRenderStreamClusterScheduler::Tick(const TArray<TSharedPtr<FRenderStreamProjectionPolicy>>& Policies, const FStreamPool& Pool, float GPUTime, FRenderStreamAssignment& Assignment)
+{
+    IDisplayClusterClusterManager* ClusterMgr = GetClusterManager();
+    if (!m_open || !ClusterMgr)
+        return;
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - m_lastReportTime >= ReportInterval)
+    {
+        Report(Policies, GPUTime);
+        m_lastReportTime = Now;
+    }
+
+    if (ClusterMgr->IsSlave() || Now - m_lastRebalanceTime < m_rebalanceInterval)
+        return;
+    m_lastRebalanceTime = Now;
+
+    // Forget nodes which stopped reporting, and wait until every node has reported at least once.
+    for (auto It = m_nodes.CreateIterator(); It; ++It)
+    {
+        if (Now - It.Value().ReceivedTime > ReportTimeout)
+            It.RemoveCurrent();
+    }
+    if (m_nodes.Num() < int32(ClusterMgr->GetNodesAmount()))
+        return;
+
+    if (Rebalance(Pool, Assignment))
+        ++Assignment.Version;
+}
+
+void FRenderStreamClusterScheduler::Report(const TArray<TSharedPtr<FRenderStreamProjectionPolicy>>& Policies, float GPUTime)
+{
+    // There is no per view GPU timing, so the node's GPU time is split between its streams by the pixels they render per second.
+    double TotalRate = 0;
+    for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : Policies)
+    {
+        if (Policy->GetStream())
+            TotalRate += double(Policy->GetViewportResolution().X) * Policy->GetViewportResolution().Y * Policy->GetRealisedFrameRate();
+    }
+
+    FString NodeId = GetClusterManager()->GetNodeId();
+    int32 NumSlots = Policies.Num();
+    FDisplayClusterClusterEventBinary Event;
+    Event.EventId = CostEventId;
+    Event.bIsSystemEvent = false;
+    Event.bShouldDiscardOnRepeat = false; // every node reports with the same id
+    FMemoryWriter Ar(Event.EventData);
+    Ar << NodeId;
+    Ar << GPUTime;
+    Ar << NumSlots;
+    for (const TSharedPtr<FRenderStreamProjectionPolicy>& Policy : Policies)
+    {
+        const TSharedPtr<FFrameStream>& Stream = Policy->GetStream();
+        FString ViewportId = Policy->GetViewportId();
+        FIntPoint Resolution = Policy->GetViewportResolution();
+        FString StreamName = Stream ? Stream->Name() : FString();
+        const double Rate = double(Resolution.X) * Resolution.Y * Policy->GetRealisedFrameRate();
+        float Cost = Stream && TotalRate > 0 ? float(GPUTime * Rate / TotalRate) : 0.f;
+        Ar << ViewportId;
+        Ar << Resolution;
+        Ar << StreamName;
+        Ar << Cost;
+    }
+
+    // Not master only, nDisplay drops those when a follower emits them.
+    GetClusterManager()->EmitClusterEventBinary(Event, false);
+}
+
+void FRenderStreamClusterScheduler::OnClusterEvent(const FDisplayClusterClusterEventBinary& Event)
+{
+    IDisplayClusterClusterManager* ClusterMgr = GetClusterManager();
+    if (Event.EventId != CostEventId || !ClusterMgr || ClusterMgr->IsSlave())
+        return;
+
+    FMemoryReader Ar(Event.EventData);
+    FString NodeId;
+    float GPUTime = 0.f;
+    int32 NumSlots = 0;
+    Ar << NodeId;
+    Ar << GPUTime;
+    Ar << NumSlots;
+    if (Ar.IsError() || NumSlots < 0 || NumSlots > 1024)
+        return;
+
+    FNodeReport& Node = m_nodes.FindOrAdd(NodeId);
+    if (Node.NodeId.IsEmpty())
+    {
+        Node.NodeId = NodeId;
+        Node.PredictedStatName = std::string(TCHAR_TO_UTF8(*NodeId)) + " Predicted Load";
+        Node.LoadStatName = std::string(TCHAR_TO_UTF8(*NodeId)) + " Load";
+    }
+    Node.GPUTime = GPUTime;
+    Node.ReceivedTime = FPlatformTime::Seconds();
+    Node.Slots.SetNum(NumSlots);
+    for (FSlot& Slot : Node.Slots)
+    {
+        Ar << Slot.ViewportId;
+        Ar << Slot.Resolution;
+        Ar << Slot.Stream;
+        Ar << Slot.Cost;
+    }
+    if (Ar.IsError())
+        m_nodes.Remove(NodeId);
+}
+
+bool FRenderStreamClusterScheduler::Rebalance(const FStreamPool& Pool, FRenderStreamAssignment& Assignment)
+{
+    // Measured costs of the streams, and the cost of a pixel to estimate those which are not rendered anywhere yet.
+    TMap<FString, float> MeasuredCosts;
+    double MeasuredCost = 0;
+    double MeasuredPixels = 0;
+    float CurrentMaxLoad = 0.f;
+    for (auto& It : m_nodes)
+    {
+        float& Load = It.Value.PredictedLoad;
+        Load = 0.f;
+        for (const FSlot& Slot : It.Value.Slots)
+        {
+            if (Slot.Stream.IsEmpty() || Slot.Cost <= 0.f)
+                continue;
+            MeasuredCosts.Add(Slot.Stream, Slot.Cost);
+            MeasuredCost += Slot.Cost;
+            MeasuredPixels += double(Slot.Resolution.X) * Slot.Resolution.Y;
+            Load += Slot.Cost;
+        }
+        CurrentMaxLoad = FMath::Max(CurrentMaxLoad, Load);
+    }
+    if (MeasuredPixels <= 0)
+        return false; // nothing to balance on yet
+    const double CostPerPixel = MeasuredCost / MeasuredPixels;
+
+    struct FStreamCost
+    {
+        FString Name;
+        FIntPoint Resolution;
+        float Cost;
+    };
+    TArray<FStreamCost> Streams;
+    for (const TSharedPtr<FFrameStream>& Stream : Pool.GetAllStreams())
+    {
+        const float* Measured = MeasuredCosts.Find(Stream->Name());
+        Streams.Add({ Stream->Name(), Stream->Resolution(), Measured ? *Measured : float(CostPerPixel * Stream->Resolution().X * Stream->Resolution().Y) });
+    }
+    Streams.StableSort([](const FStreamCost& A, const FStreamCost& B) { return A.Cost > B.Cost; });
+
+    // Longest processing time first: each stream goes to the least loaded node with a free viewport of its resolution,
+    // preferring the viewport it is already on so equal loads do not move it.
+    TMap<FString, float> Loads;
+    TSet<FString> UsedViewports;
+    TMap<FString, FString> NewStreams;
+    for (const auto& It : m_nodes)
+    {
+        Loads.Add(It.Key, 0.f);
+        for (const FSlot& Slot : It.Value.Slots)
+            NewStreams.Add(Slot.ViewportId, FString());
+    }
+
+    for (const FStreamCost& Stream : Streams)
+    {
+        const FNodeReport* BestNode = nullptr;
+        const FSlot* BestSlot = nullptr;
+        for (const auto& It : m_nodes)
+        {
+            for (const FSlot& Slot : It.Value.Slots)
+            {
+                if (Slot.Resolution != Stream.Resolution || UsedViewports.Contains(Slot.ViewportId))
+                    continue;
+                const bool Better = !BestNode || Loads[It.Key] < Loads[BestNode->NodeId] ||
+                    (Loads[It.Key] == Loads[BestNode->NodeId] && Slot.Stream == Stream.Name);
+                if (Better)
+                {
+                    BestNode = &It.Value;
+                    BestSlot = &Slot;
+                }
+            }
+        }
+
+        if (!BestSlot)
+        {
+            UE_LOG(LogRenderStream, Verbose, TEXT("No viewport of %dx%d free for stream '%s'"), Stream.Resolution.X, Stream.Resolution.Y, *Stream.Name);
+            continue;
+        }
+        UsedViewports.Add(BestSlot->ViewportId);
+        NewStreams[BestSlot->ViewportId] = Stream.Name;
+        Loads[BestNode->NodeId] += Stream.Cost;
+    }
+
+    float NewMaxLoad = 0.f;
+    for (const auto& It : Loads)
+        NewMaxLoad = FMath::Max(NewMaxLoad, It.Value);
+
+    // Until a new assignment is made, the prediction is what the current one measures.
+    if (NewMaxLoad >= CurrentMaxLoad * (1.f - m_rebalanceThreshold) || NewStreams.OrderIndependentCompareEqual(Assignment.Streams))
+        return false;
+
+    for (auto& It : m_nodes)
+        It.Value.PredictedLoad = Loads[It.Key];
+
+    UE_LOG(LogRenderStream, Log, TEXT("Rebalancing streams, predicted busiest node load %.2f ms from %.2f ms"), NewMaxLoad, CurrentMaxLoad);
+    for (const auto& It : NewStreams)
+        UE_LOG(LogRenderStream, Log, TEXT("  %s: %s"), *It.Key, It.Value.IsEmpty() ? TEXT("idle") : *It.Value);
+    Assignment.Streams = MoveTemp(NewStreams);
+    return true;
+}
+
+void FRenderStreamClusterScheduler::AddProfilingEntries(TArray<RenderStreamLink::ProfilingEntry>& Entries) const
+{
+    for (const auto& It : m_nodes)
+    {
+        Entries.Push({ It.Value.PredictedStatName.c_str(), It.Value.PredictedLoad });
+        Entries.Push({ It.Value.LoadStatName.c_str(), It.Value.GPUTime });
+    }
+}
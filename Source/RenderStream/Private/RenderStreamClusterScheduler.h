@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Cluster/DisplayClusterClusterEvent.h"
+#include "Cluster/IDisplayClusterClusterManager.h"
+#include "RenderStreamLink.h"
+
+#include <string>
+
+class FFrameStream;
+class FRenderStreamProjectionPolicy;
+class FStreamPool;
+
+// Which stream each renderstream viewport in the cluster renders, keyed by viewport id, which nDisplay keeps unique across
+// the cluster. An empty stream leaves the viewport idle. Without an assignment a viewport renders the stream of its name.
+struct FRenderStreamAssignment
+{
+    uint32 Version = 0;
+    TMap<FString, FString> Streams;
+};
+
+// Balances streams across the cluster by their measured cost. Every node reports the viewports it has and what the
+// streams bound to them cost through an nDisplay cluster event, once a second. The controller assigns streams to
+// viewports of the same resolution, most expensive first onto the least loaded node, and distributes the assignment
+// through the sync object so every node rebinds on the same frame. A new assignment is only made when it lowers the
+// predicted load of the busiest node by more than the configured threshold, so streams do not move back and forth.
+class FRenderStreamClusterScheduler
+{
+public:
+    ~FRenderStreamClusterScheduler();
+
+    void Open(float InRebalanceInterval, float InRebalanceThreshold);
+    void Close();
+    bool IsOpen() const { return m_open; }
+    // The cluster manager forgets its listeners on map load.
+    void RegisterListener();
+
+    // Call once per frame on the game thread. Reports this node's costs, and on the controller updates Assignment
+    // when the cluster is better balanced by a new one.
+    void Tick(const TArray<TSharedPtr<FRenderStreamProjectionPolicy>>& Policies, const FStreamPool& Pool, float GPUTime, FRenderStreamAssignment& Assignment);
+
+    // Predicted and reported load per node, controller only.
+    void AddProfilingEntries(TArray<RenderStreamLink::ProfilingEntry>& Entries) const;
+
+private:
+    struct FSlot
+    {
+        FString ViewportId;
+        FIntPoint Resolution;
+        FString Stream;
+        float Cost; // milliseconds of GPU time per frame, 0 when unmeasured
+    };
+
+    struct FNodeReport
+    {
+        FString NodeId;
+        float GPUTime = 0.f;
+        TArray<FSlot> Slots;
+        double ReceivedTime = 0;
+        float PredictedLoad = 0.f;
+        std::string PredictedStatName;
+        std::string LoadStatName;
+    };
+
+    void Report(const TArray<TSharedPtr<FRenderStreamProjectionPolicy>>& Policies, float GPUTime);
+    void OnClusterEvent(const FDisplayClusterClusterEventBinary& Event);
+    bool Rebalance(const FStreamPool& Pool, FRenderStreamAssignment& Assignment);
+
+    bool m_open = false;
+    float m_rebalanceInterval = 0.f;
+    float m_rebalanceThreshold = 0.f;
+    double m_lastReportTime = 0;
+    double m_lastRebalanceTime = 0;
+
+    FOnClusterEventBinaryListener m_listener;
+    TMap<FString, FNodeReport> m_nodes; // controller only
+};
@@ -0,0 +1,197 @@
+#include "RenderStreamClusterTimings.h"
+
+#include "RenderStream.h"
+
+#include "IDisplayCluster.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Binary cluster event ids, distinct from any the project emits itself, see RenderStreamClusterScheduler.cpp.
+static constexpr int32 TimingEventId = 0x52530002;
+
+namespace {
+    IDisplayClusterClusterManager* GetClusterManager()
+    {
+        return IDisplayCluster::IsAvailable() ? IDisplayCluster::Get().GetClusterMgr() : nullptr;
+    }
+
+    void SerializeTiming(FArchive& Ar, uint16& NodeIndex, FRenderStreamNodeTiming& Timing)
+    {
+        Ar << NodeIndex;
+        Ar << Timing.TrackedTime;
+        Ar << Timing.ReceiveTime;
+        Ar << Timing.GameTime;
+        Ar << Timing.RenderTime;
+        Ar << Timing.GPUTime;
+        Ar << Timing.SendTime;
+    }
+}
+
+FRenderStreamClusterTimings::~FRenderStreamClusterTimings()
+{
+    Close();
+}
+
+void FRenderStreamClusterTimings::Open()
+{
+    IDisplayClusterClusterManager* ClusterMgr = GetClusterManager();
+    if (m_open || !ClusterMgr)
+        return;
+
+    // Every node sorts the same ids, so a record only needs to carry its node's index.
+    ClusterMgr->GetNodeIds(m_nodeIds);
+    m_nodeIds.Sort();
+    m_nodeIndex = uint16(FMath::Max(m_nodeIds.IndexOfByKey(ClusterMgr->GetNodeId()), 0));
+
+    m_nodes.SetNum(m_nodeIds.Num());
+    for (int32 i = 0; i < m_nodeIds.Num(); ++i)
+    {
+        const std::string Prefix = TCHAR_TO_UTF8(*m_nodeIds[i]);
+        m_nodes[i].ReceiveStatName = Prefix + " Receive Time";
+        m_nodes[i].CriticalPathStatName = Prefix + " Critical Path";
+        m_nodes[i].SendStatName = Prefix + " Send Time";
+    }
+    for (FPendingFrame& Frame : m_pending)
+    {
+        Frame.Nodes.SetNumZeroed(m_nodeIds.Num());
+        Frame.Received.Init(false, m_nodeIds.Num());
+    }
+
+    m_listener = FOnClusterEventBinaryListener::CreateRaw(this, &FRenderStreamClusterTimings::OnClusterEvent);
+    m_open = true;
+    RegisterListener();
+}
+
+void FRenderStreamClusterTimings::Close()
+{
+    if (!m_open)
+        return;
+
+    if (IDisplayClusterClusterManager* ClusterMgr = GetClusterManager())
+        ClusterMgr->RemoveClusterEventBinaryListener(m_listener);
+    m_listener.Unbind();
+    m_open = false;
+}
+
+void FRenderStreamClusterTimings::RegisterListener()
+{
+    IDisplayClusterClusterManager* ClusterMgr = GetClusterManager();
+    if (!m_open || !ClusterMgr || ClusterMgr->IsSlave())
+        return;
+
+    ClusterMgr->RemoveClusterEventBinaryListener(m_listener);
+    ClusterMgr->AddClusterEventBinaryListener(m_listener);
+}
+
+void FRenderStreamClusterTimings::Record(const FRenderStreamNodeTiming& Timing)
+{
+    IDisplayClusterClusterManager* ClusterMgr = GetClusterManager();
+    if (!m_open || !ClusterMgr)
+        return;
+
+    if (!ClusterMgr->IsSlave())
+    {
+        Aggregate(m_nodeIndex, Timing);
+        return;
+    }
+
+    FDisplayClusterClusterEventBinary Event;
+    Event.EventId = TimingEventId;
+    Event.bIsSystemEvent = false;
+    Event.bShouldDiscardOnRepeat = false; // every node records with the same id
+    FMemoryWriter Ar(Event.EventData);
+    FRenderStreamNodeTiming Record = Timing;
+    SerializeTiming(Ar, m_nodeIndex, Record);
+    // Not master only, nDisplay drops those when a follower emits them.
+    ClusterMgr->EmitClusterEventBinary(Event, false);
+}
+
+void FRenderStreamClusterTimings::OnClusterEvent(const FDisplayClusterClusterEventBinary& Event)
+{
+    if (Event.EventId != TimingEventId)
+        return;
+
+    FMemoryReader Ar(Event.EventData);
+    uint16 NodeIndex = 0;
+    FRenderStreamNodeTiming Timing;
+    SerializeTiming(Ar, NodeIndex, Timing);
+    if (!Ar.IsError() && NodeIndex < m_nodes.Num())
+        Aggregate(NodeIndex, Timing);
+}
+
+void FRenderStreamClusterTimings::Aggregate(int32 NodeIndex, const FRenderStreamNodeTiming& Timing)
+{
+    int32 Frame = INDEX_NONE;
+    for (int32 i = 0; i < MaxPendingFrames; ++i)
+    {
+        if (m_pending[i].TrackedTime == Timing.TrackedTime)
+        {
+            Frame = i;
+            break;
+        }
+    }
+
+    if (Frame == INDEX_NONE)
+    {
+        // Reuse the oldest slot, finishing its frame with the records which did arrive.
+        Frame = m_next;
+        m_next = (m_next + 1) % MaxPendingFrames;
+        if (m_pending[Frame].NumReceived > 0)
+            Finish(Frame);
+        m_pending[Frame].TrackedTime = Timing.TrackedTime;
+    }
+
+    FPendingFrame& Pending = m_pending[Frame];
+    if (Pending.Received[NodeIndex])
+        return;
+    Pending.Nodes[NodeIndex] = Timing;
+    Pending.Received[NodeIndex] = true;
+    if (++Pending.NumReceived == m_nodes.Num())
+        Finish(Frame);
+}
+
+void FRenderStreamClusterTimings::Finish(int32 Frame)
+{
+    FPendingFrame& Pending = m_pending[Frame];
+
+    float CriticalPath = 0.f;
+    int32 SlowestNode = INDEX_NONE;
+    for (int32 i = 0; i < m_nodes.Num(); ++i)
+    {
+        if (!Pending.Received[i])
+            continue;
+        m_nodes[i].Latest = Pending.Nodes[i];
+        if (Pending.Nodes[i].CriticalPath() > CriticalPath || SlowestNode == INDEX_NONE)
+        {
+            CriticalPath = Pending.Nodes[i].CriticalPath();
+            SlowestNode = i;
+        }
+    }
+
+    // A frame missing nodes can only show which of those which arrived was slowest.
+    if (SlowestNode != INDEX_NONE)
+    {
+        m_criticalPath = CriticalPath;
+        m_slowestNode = SlowestNode;
+    }
+
+    Pending.TrackedTime = -1;
+    Pending.Received.Init(false, m_nodes.Num());
+    Pending.NumReceived = 0;
+}
+
+void FRenderStreamClusterTimings::AddProfilingEntries(TArray<RenderStreamLink::ProfilingEntry>& Entries) const
+{
+    if (!m_open || m_slowestNode == INDEX_NONE)
+        return;
+
+    for (const FNode& Node : m_nodes)
+    {
+        Entries.Push({ Node.ReceiveStatName.c_str(), Node.Latest.ReceiveTime });
+        Entries.Push({ Node.CriticalPathStatName.c_str(), Node.Latest.CriticalPath() });
+        Entries.Push({ Node.SendStatName.c_str(), Node.Latest.SendTime });
+    }
+    Entries.Push({ "Cluster Critical Path", m_criticalPath });
+    // Index into the node ids in sorted order, the same order as the per node entries.
+    Entries.Push({ "Slowest Node", float(m_slowestNode) });
+}
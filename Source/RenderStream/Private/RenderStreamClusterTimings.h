@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Cluster/DisplayClusterClusterEvent.h"
+#include "Cluster/IDisplayClusterClusterManager.h"
+#include "RenderStreamLink.h"
+
+#include <string>
+
+// One node's timings of one frame, in milliseconds.
+struct FRenderStreamNodeTiming
+{
+    double TrackedTime; // d3 tracked time of the frame, the same on every node
+    float ReceiveTime;  // awaiting frame data on the controller, receiving it on followers
+    float GameTime;
+    float RenderTime;
+    float GPUTime;
+    float SendTime;     // all streams
+
+    // The stage which limits the node's frame rate, and so how long the cluster barrier waits for it.
+    float CriticalPath() const { return FMath::Max3(GameTime, RenderTime, GPUTime) + SendTime; }
+};
+
+// Gathers every node's frame timings on the controller, so d3 sees which node holds up the nDisplay barrier.
+// Followers send their record each frame as a binary cluster event, which travels with nDisplay's existing event
+// sync rather than adding a round-trip. Records arrive a few frames late and are matched up by tracked time.
+class FRenderStreamClusterTimings
+{
+public:
+    ~FRenderStreamClusterTimings();
+
+    void Open();
+    void Close();
+    bool IsOpen() const { return m_open; }
+    // The cluster manager forgets its listeners on map load.
+    void RegisterListener();
+
+    // Call once per frame on the game thread with this node's timings.
+    void Record(const FRenderStreamNodeTiming& Timing);
+
+    // Per node and critical path entries of the last complete frame, controller only.
+    void AddProfilingEntries(TArray<RenderStreamLink::ProfilingEntry>& Entries) const;
+
+private:
+    void OnClusterEvent(const FDisplayClusterClusterEventBinary& Event);
+    void Aggregate(int32 NodeIndex, const FRenderStreamNodeTiming& Timing);
+    void Finish(int32 Frame);
+
+    struct FNode
+    {
+        FRenderStreamNodeTiming Latest = {};
+        std::string ReceiveStatName;
+        std::string CriticalPathStatName;
+        std::string SendStatName;
+    };
+
+    // Frames waiting for the records of every node, older frames are finished with what arrived.
+    static constexpr int32 MaxPendingFrames = 8;
+    struct FPendingFrame
+    {
+        double TrackedTime = -1;
+        TArray<FRenderStreamNodeTiming> Nodes;
+        TBitArray<> Received;
+        int32 NumReceived = 0;
+    };
+
+    bool m_open = false;
+    uint16 m_nodeIndex = 0;
+    TArray<FString> m_nodeIds;
+    FOnClusterEventBinaryListener m_listener;
+
+    // Controller only.
+    TArray<FNode> m_nodes;
+    FPendingFrame m_pending[MaxPendingFrames];
+    int32 m_next = 0;
+    float m_criticalPath = 0.f;
+    int32 m_slowestNode = INDEX_NONE;
+};
@@ -0,0 +1,350 @@
+#include "RenderStreamDmx.h"
+
+#include "RenderStream.h"
+#include "RenderStreamMemory.h"
+
+#include "Common/UdpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+// Both protocols fit a full universe well within this.
+static constexpr int32 MaxPacketSize = 1024;
+// How long the receive thread waits for a packet before it checks whether to stop.
+static constexpr double WaitInterval = 0.1;
+
+static const uint8 ArtNetId[8] = { 'A', 'r', 't', '-', 'N', 'e', 't', 0 };
+static constexpr uint16 ArtDmxOpCode = 0x5000;
+static constexpr int32 ArtDmxHeaderSize = 18;
+
+static const uint8 ACNPacketId[12] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+static constexpr int32 SACNHeaderSize = 126; // root, framing and DMP layers up to and including the start code
+
+namespace {
+    uint16 ReadBigEndian16(const uint8* Data)
+    {
+        return uint16(Data[0] << 8 | Data[1]);
+    }
+
+    uint32 ReadBigEndian32(const uint8* Data)
+    {
+        return uint32(Data[0]) << 24 | uint32(Data[1]) << 16 | uint32(Data[2]) << 8 | Data[3];
+    }
+
+    void WriteBigEndian16(uint8* Data, uint16 Value)
+    {
+        Data[0] = uint8(Value >> 8);
+        Data[1] = uint8(Value);
+    }
+
+    void WriteBigEndian32(uint8* Data, uint32 Value)
+    {
+        WriteBigEndian16(Data, uint16(Value >> 16));
+        WriteBigEndian16(Data + 2, uint16(Value));
+    }
+
+    // Channels a parameter takes, 0 for layouts this receiver does not know.
+    int32 DmxWidth(uint32 DmxType)
+    {
+        switch (ERenderStreamDmxType(DmxType))
+        {
+        case ERenderStreamDmxType::Dmx8: return 1;
+        case ERenderStreamDmxType::Dmx16LittleEndian: return 2;
+        case ERenderStreamDmxType::Dmx16BigEndian: return 2;
+        default: return 0;
+        }
+    }
+}
+
+bool RenderStreamDmx::Parse(const uint8* Packet, int32 Size, int32& OutUniverse, const uint8*& OutData, int32& OutLength)
+{
+    if (Size >= ArtDmxHeaderSize && FMemory::Memcmp(Packet, ArtNetId, sizeof(ArtNetId)) == 0)
+    {
+        // Art-Net's op code is the one little endian field.
+        if (uint16(Packet[8] | Packet[9] << 8) != ArtDmxOpCode)
+            return false;
+        OutUniverse = (Packet[15] & 0x7f) << 8 | Packet[14];
+        OutLength = FMath::Min<int32>(ReadBigEndian16(Packet + 16), Size - ArtDmxHeaderSize);
+        OutData = Packet + ArtDmxHeaderSize;
+        return OutLength > 0;
+    }
+
+    if (Size >= SACNHeaderSize && ReadBigEndian16(Packet) == 0x0010 && FMemory::Memcmp(Packet + 4, ACNPacketId, sizeof(ACNPacketId)) == 0)
+    {
+        const uint8 Options = Packet[112];
+        const bool bData = ReadBigEndian32(Packet + 18) == 0x00000004 && ReadBigEndian32(Packet + 40) == 0x00000002 && Packet[117] == 0x02;
+        // Preview data is for visualisers, a terminated stream's last packet holds no new levels, other start codes are not levels.
+        if (!bData || (Options & 0xc0) != 0 || Packet[125] != 0)
+            return false;
+        OutUniverse = ReadBigEndian16(Packet + 113);
+        OutLength = FMath::Min<int32>(ReadBigEndian16(Packet + 123) - 1, Size - SACNHeaderSize);
+        OutData = Packet + SACNHeaderSize;
+        return OutLength > 0;
+    }
+
+    return false;
+}
+
+void RenderStreamDmx::BuildArtDmx(TArray<uint8>& Out, int32 Universe, uint8 Sequence, const uint8* Data, int32 Length)
+{
+    Length = FMath::Min(Length, UniverseSize);
+    Out.SetNumZeroed(ArtDmxHeaderSize + Length);
+    uint8* Packet = Out.GetData();
+    FMemory::Memcpy(Packet, ArtNetId, sizeof(ArtNetId));
+    Packet[8] = uint8(ArtDmxOpCode);
+    Packet[9] = uint8(ArtDmxOpCode >> 8);
+    Packet[11] = 14; // protocol version
+    Packet[12] = Sequence;
+    Packet[14] = uint8(Universe);
+    Packet[15] = uint8(Universe >> 8) & 0x7f;
+    WriteBigEndian16(Packet + 16, uint16(Length));
+    FMemory::Memcpy(Packet + ArtDmxHeaderSize, Data, Length);
+}
+
+void RenderStreamDmx::BuildSACN(TArray<uint8>& Out, int32 Universe, uint8 Sequence, const uint8* Data, int32 Length)
+{
+    Length = FMath::Min(Length, UniverseSize);
+    Out.SetNumZeroed(SACNHeaderSize + Length);
+    uint8* Packet = Out.GetData();
+    const int32 Size = Out.Num();
+
+    // Root layer
+    WriteBigEndian16(Packet, 0x0010);
+    FMemory::Memcpy(Packet + 4, ACNPacketId, sizeof(ACNPacketId));
+    WriteBigEndian16(Packet + 16, uint16(0x7000 | (Size - 16)));
+    WriteBigEndian32(Packet + 18, 0x00000004);
+    FMemory::Memcpy(Packet + 22, "RenderStreamDmx!", 16); // CID
+
+    // Framing layer
+    WriteBigEndian16(Packet + 38, uint16(0x7000 | (Size - 38)));
+    WriteBigEndian32(Packet + 40, 0x00000002);
+    FCStringAnsi::Strncpy(reinterpret_cast<ANSICHAR*>(Packet + 44), "RenderStream DMX sender", 64);
+    Packet[108] = 100; // priority
+    Packet[111] = Sequence;
+    WriteBigEndian16(Packet + 113, uint16(Universe));
+
+    // DMP layer
+    WriteBigEndian16(Packet + 115, uint16(0x7000 | (Size - 115)));
+    Packet[117] = 0x02;
+    Packet[118] = 0xa1;
+    WriteBigEndian16(Packet + 121, 1);
+    WriteBigEndian16(Packet + 123, uint16(Length + 1));
+    FMemory::Memcpy(Packet + SACNHeaderSize, Data, Length);
+}
+
+FRenderStreamDmxReceiver::~FRenderStreamDmxReceiver()
+{
+    if (m_thread)
+        Close();
+}
+
+bool FRenderStreamDmxReceiver::Open(int32 Port, int32 InFirstUniverse, int32 InNumUniverses)
+{
+    if (m_thread)
+        return true;
+
+    m_socket = FUdpSocketBuilder(TEXT("RenderStreamDmx"))
+        .AsNonBlocking()
+        .AsReusable()
+        .BoundToPort(Port)
+        .WithReceiveBufferSize(256 * 1024)
+        .Build();
+    if (!m_socket)
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Unable to receive DMX on UDP port %d"), Port);
+        return false;
+    }
+
+    // sACN consoles multicast each universe to its own group, 239.255.<hi>.<lo>, on the sACN port.
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    const int32 LastUniverse = FMath::Min(InFirstUniverse + FMath::Max(InNumUniverses, 1), RenderStreamDmx::MaxSACNUniverse + 1);
+    for (int32 Universe = FMath::Max(InFirstUniverse, 1); Universe < LastUniverse; ++Universe)
+    {
+        TSharedRef<FInternetAddr> Group = SocketSubsystem->CreateInternetAddr();
+        Group->SetIp(FIPv4Address(239, 255, uint8(Universe >> 8), uint8(Universe)).Value);
+        if (!m_socket->JoinMulticastGroup(*Group))
+            UE_LOG(LogRenderStream, Warning, TEXT("Unable to join the sACN multicast group of universe %d"), Universe);
+    }
+    if (Port != RenderStreamDmx::SACNPort)
+        UE_LOG(LogRenderStream, Log, TEXT("Multicast sACN is sent to port %d, DMX is received on %d"), RenderStreamDmx::SACNPort, Port);
+
+    RS_LLM_SCOPE(ERenderStreamMemory::Diagnostics);
+    m_firstUniverse = InFirstUniverse;
+    m_numUniverses = FMath::Max(InNumUniverses, 1);
+    m_universes.SetNumZeroed(m_numUniverses * RenderStreamDmx::UniverseSize);
+    m_received.Init(false, m_numUniverses);
+    m_mergedHash = 0;
+    m_parameters.Empty();
+
+    UE_LOG(LogRenderStream, Log, TEXT("Receiving DMX universes %d-%d on UDP port %d"), m_firstUniverse, m_firstUniverse + m_numUniverses - 1, Port);
+    m_stop = false;
+    m_thread = FRunnableThread::Create(this, TEXT("RenderStreamDmx"), 0, TPri_AboveNormal);
+    return true;
+}
+
+void FRenderStreamDmxReceiver::Close()
+{
+    if (!m_thread)
+        return;
+
+    m_thread->Kill(true);
+    delete m_thread;
+    m_thread = nullptr;
+
+    m_socket->Close();
+    ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(m_socket);
+    m_socket = nullptr;
+}
+
+uint32 FRenderStreamDmxReceiver::Run()
+{
+    TArray<uint8> Packet;
+    Packet.SetNumUninitialized(MaxPacketSize);
+    while (!m_stop)
+    {
+        if (!m_socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(WaitInterval)))
+            continue;
+
+        int32 Size = 0;
+        while (!m_stop && m_socket->Recv(Packet.GetData(), Packet.Num(), Size) && Size > 0)
+            Receive(Packet.GetData(), Size);
+    }
+    return 0;
+}
+
+void FRenderStreamDmxReceiver::Stop()
+{
+    m_stop = true;
+}
+
+void FRenderStreamDmxReceiver::Receive(const uint8* Packet, int32 Size)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    int32 Universe = 0;
+    const uint8* Data = nullptr;
+    int32 Length = 0;
+    if (!RenderStreamDmx::Parse(Packet, Size, Universe, Data, Length))
+        return;
+
+    const int32 Index = Universe - m_firstUniverse;
+    if (Index < 0 || Index >= m_numUniverses)
+        return;
+
+    {
+        FScopeLock Lock(&m_lock);
+        FMemory::Memcpy(&m_universes[Index * RenderStreamDmx::UniverseSize], Data, FMath::Min(Length, RenderStreamDmx::UniverseSize));
+        m_received[Index] = true;
+    }
+
+    m_packets.fetch_add(1, std::memory_order_relaxed);
+    m_receiveCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+}
+
+void FRenderStreamDmxReceiver::Merge(const RenderStreamLink::RemoteParameters& Parameters, float* Values, size_t NumValues)
+{
+    RS_LLM_SCOPE(ERenderStreamMemory::Diagnostics);
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 Num = int32(FMath::Min<size_t>(NumValues, Parameters.nParameters));
+
+    if (!IsOpen())
+    {
+        // A follower, the controller's merge of the same frame.
+        if (m_merged.Hash == Parameters.hash)
+        {
+            for (int32 i = 0; i < m_merged.Indices.Num(); ++i)
+            {
+                if (m_merged.Indices[i] < Num)
+                    Values[m_merged.Indices[i]] = m_merged.Values[i];
+            }
+        }
+        return;
+    }
+
+    if (Parameters.hash != m_mergedHash || m_parameters.Num() != Num)
+    {
+        m_mergedHash = Parameters.hash;
+        m_parameters.SetNum(Num);
+        for (int32 i = 0; i < Num; ++i)
+            m_parameters[i] = { Parameters.parameters[i].dmxOffset, NAN, -1, false };
+    }
+
+    // Copy out under the lock, decode without it.
+    m_raw.SetNumUninitialized(Num);
+    {
+        FScopeLock Lock(&m_lock);
+        const int32 NumChannels = m_numUniverses * RenderStreamDmx::UniverseSize;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            const int32 Channel = m_parameters[i].Channel;
+            const int32 Width = DmxWidth(Parameters.parameters[i].dmxType);
+            const bool bReceived = Channel >= 0 && Width > 0 && Channel + Width <= NumChannels &&
+                m_received[Channel / RenderStreamDmx::UniverseSize] && m_received[(Channel + Width - 1) / RenderStreamDmx::UniverseSize];
+            if (!bReceived)
+                m_raw[i] = -1;
+            else if (Width == 1)
+                m_raw[i] = m_universes[Channel];
+            else
+                m_raw[i] = m_universes[Channel] << 8 | m_universes[Channel + 1];
+        }
+    }
+
+    m_merged.Hash = Parameters.hash;
+    m_merged.Indices.Reset();
+    m_merged.Values.Reset();
+    for (int32 i = 0; i < Num; ++i)
+    {
+        const RenderStreamLink::RemoteParameter& Parameter = Parameters.parameters[i];
+        FParameterState& State = m_parameters[i];
+        int32 Raw = m_raw[i];
+        if (Raw >= 0 && ERenderStreamDmxType(Parameter.dmxType) == ERenderStreamDmxType::Dmx16LittleEndian)
+            Raw = (Raw & 0xff) << 8 | Raw >> 8;
+
+        // Both changing on the same frame goes to DMX, it is the faster source.
+        if (Raw >= 0 && Raw != State.LastRaw)
+            State.bDmx = true;
+        else if (Values[i] != State.LastValue)
+            State.bDmx = false;
+        State.LastValue = Values[i];
+        State.LastRaw = Raw;
+
+        if (State.bDmx)
+        {
+            const float MaxRaw = DmxWidth(Parameter.dmxType) == 1 ? 255.f : 65535.f;
+            Values[i] = FMath::Lerp(Parameter.min, Parameter.max, Raw / MaxRaw);
+            m_merged.Indices.Add(i);
+            m_merged.Values.Add(Values[i]);
+        }
+    }
+
+    m_decodeTime += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+}
+
+void FRenderStreamDmxReceiver::AddProfilingEntries(TArray<RenderStreamLink::ProfilingEntry>& Entries)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (Now - m_rateTime >= 1.0)
+    {
+        const uint32 Packets = m_packets.load(std::memory_order_relaxed);
+        const uint64 Cycles = m_receiveCycles.load(std::memory_order_relaxed);
+        const uint32 NewPackets = Packets - m_ratePackets;
+        m_packetRate = m_rateTime > 0 ? float(NewPackets / (Now - m_rateTime)) : 0.f;
+        m_receiveTime = NewPackets ? float(FPlatformTime::ToMilliseconds64(Cycles - m_rateCycles) / NewPackets) : 0.f;
+        m_ratePackets = Packets;
+        m_rateCycles = Cycles;
+        m_rateTime = Now;
+    }
+
+    Entries.Push({ "DMX Packet Rate", m_packetRate });
+    Entries.Push({ "DMX Receive Time", m_receiveTime });
+    Entries.Push({ "DMX Decode Time", float(m_decodeTime) });
+    m_decodeTime = 0;
+}
+
+FRenderStreamDmxReceiver& RenderStreamDmxReceiver()
+{
+    static FRenderStreamDmxReceiver Receiver;
+    return Receiver;
+}
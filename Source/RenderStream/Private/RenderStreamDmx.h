@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "RenderStreamLink.h"
+
+#include <atomic>
+
+class FRunnableThread;
+class FSocket;
+
+// Channel layouts of RemoteParameter::dmxType, numbered as d3 numbers them.
+enum class ERenderStreamDmxType : uint32
+{
+    Dmx8 = 0,
+    Dmx16LittleEndian = 1,
+    Dmx16BigEndian = 2,
+};
+
+// The parameters DMX drove in the controller's last merge, sent to the followers with the frame data.
+struct FRenderStreamDmxValues
+{
+    uint64 Hash = 0; // of the scene's parameters
+    TArray<int32> Indices;
+    TArray<float> Values;
+};
+
+namespace RenderStreamDmx
+{
+    static constexpr int32 UniverseSize = 512;
+    static constexpr int32 ArtNetPort = 6454;
+    static constexpr int32 SACNPort = 5568;
+    static constexpr int32 MaxSACNUniverse = 63999;
+
+    // Parses an ArtDmx or E1.31 data packet. Data points into Packet.
+    bool Parse(const uint8* Packet, int32 Size, int32& OutUniverse, const uint8*& OutData, int32& OutLength);
+
+    // Builds packets for the loopback sender, see URenderStreamDmxSendCommandlet.
+    void BuildArtDmx(TArray<uint8>& Out, int32 Universe, uint8 Sequence, const uint8* Data, int32 Length);
+    void BuildSACN(TArray<uint8>& Out, int32 Universe, uint8 Sequence, const uint8* Data, int32 Length);
+}
+
+// Receives DMX universes over UDP as an additional parameter source, for lighting consoles which drive the project
+// directly. Art-Net and sACN (E1.31) packets are both accepted on the one port. Universes are numbered as the protocol
+// numbers them, and the parameter address space starts at the first universe: a parameter's dmxOffset is its first
+// channel counted from there. Parameters with a dmxOffset of -1 are left to d3, properties opt in to DMX in the editor.
+// The sACN multicast groups of the received universes are joined, so consoles which multicast are received too.
+//
+// Values are merged into each frame's parameters from d3 by the last writer: a parameter follows DMX once its channels
+// change and follows d3 again once d3's value changes. Only the controller receives and merges. The values DMX drove
+// travel with the frame data, so followers apply the same values on the same frame instead of reading their own socket.
+class FRenderStreamDmxReceiver : public FRunnable
+{
+public:
+    virtual ~FRenderStreamDmxReceiver();
+
+    bool Open(int32 Port, int32 InFirstUniverse, int32 InNumUniverses);
+    void Close();
+    bool IsOpen() const { return m_thread != nullptr; }
+
+    // Game thread. Overwrites Values, the parameters of one scene as d3 sent them, where DMX wrote last. Followers
+    // overwrite them with the values of the controller's merge instead.
+    void Merge(const RenderStreamLink::RemoteParameters& Parameters, float* Values, size_t NumValues);
+
+    // Game thread. The controller's last merge, and the follower's copy of it for this frame.
+    const FRenderStreamDmxValues& MergedValues() const { return m_merged; }
+    void SetMergedValues(const FRenderStreamDmxValues& Merged) { m_merged = Merged; }
+
+    SIZE_T AllocatedSize() const
+    {
+        return m_universes.GetAllocatedSize() + m_parameters.GetAllocatedSize() + m_raw.GetAllocatedSize() +
+            m_merged.Indices.GetAllocatedSize() + m_merged.Values.GetAllocatedSize();
+    }
+
+    // Packet rate, receive and decode time.
+    void AddProfilingEntries(TArray<RenderStreamLink::ProfilingEntry>& Entries);
+
+private:
+    /** FRunnable implementation */
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+    void Receive(const uint8* Packet, int32 Size);
+
+    FSocket* m_socket = nullptr;
+    int32 m_firstUniverse = 0;
+    int32 m_numUniverses = 0;
+
+    FCriticalSection m_lock; // guards m_universes and m_received
+    TArray<uint8> m_universes;
+    TBitArray<> m_received;
+
+    std::atomic<uint32> m_packets { 0 };
+    std::atomic<uint64> m_receiveCycles { 0 };
+
+    // Game thread, per parameter of the scene merged last.
+    struct FParameterState
+    {
+        int32 Channel;
+        float LastValue;  // from d3
+        int32 LastRaw;    // from DMX, -1 before its universe arrived
+        bool bDmx;        // DMX wrote last
+    };
+    uint64 m_mergedHash = 0;
+    TArray<FParameterState> m_parameters;
+    TArray<int32> m_raw;
+    FRenderStreamDmxValues m_merged;
+    double m_decodeTime = 0;
+
+    uint32 m_ratePackets = 0;
+    uint64 m_rateCycles = 0;
+    double m_rateTime = 0;
+    float m_packetRate = 0.f;
+    float m_receiveTime = 0.f;
+
+    FRunnableThread* m_thread = nullptr;
+    std::atomic<bool> m_stop { false };
+};
+
+FRenderStreamDmxReceiver& RenderStreamDmxReceiver();
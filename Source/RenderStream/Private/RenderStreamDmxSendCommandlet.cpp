@@ -0,0 +1,99 @@
+#include "RenderStreamDmxSendCommandlet.h"
+
+#include "RenderStreamDmx.h"
+
+#include "Common/UdpSocketBuilder.h"
+#include "HAL/PlatformProcess.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRenderStreamDmxSend, Log, All);
+
+URenderStreamDmxSendCommandlet::URenderStreamDmxSendCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 URenderStreamDmxSendCommandlet::Main(const FString& Params)
+{
+    FString Protocol = TEXT("ArtNet");
+    FParse::Value(*Params, TEXT("Protocol="), Protocol);
+    const bool bSACN = Protocol.Equals(TEXT("sACN"), ESearchCase::IgnoreCase);
+    if (!bSACN && !Protocol.Equals(TEXT("ArtNet"), ESearchCase::IgnoreCase))
+    {
+        UE_LOG(LogRenderStreamDmxSend, Error, TEXT("Unknown protocol '%s', use ArtNet or sACN"), *Protocol);
+        return 1;
+    }
+    FString Host = TEXT("127.0.0.1");
+    FParse::Value(*Params, TEXT("Host="), Host);
+    int32 Port = bSACN ? RenderStreamDmx::SACNPort : RenderStreamDmx::ArtNetPort;
+    FParse::Value(*Params, TEXT("Port="), Port);
+    int32 FirstUniverse = 0;
+    FParse::Value(*Params, TEXT("Universe="), FirstUniverse);
+    int32 NumUniverses = 1;
+    FParse::Value(*Params, TEXT("Universes="), NumUniverses);
+    float Rate = 44.f;
+    FParse::Value(*Params, TEXT("Rate="), Rate);
+    int32 Count = 0;
+    FParse::Value(*Params, TEXT("Count="), Count);
+    int32 Value = -1;
+    FParse::Value(*Params, TEXT("Value="), Value);
+
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+    bool bValid = false;
+    Address->SetIp(*Host, bValid);
+    Address->SetPort(Port);
+    if (!bValid)
+    {
+        UE_LOG(LogRenderStreamDmxSend, Error, TEXT("Invalid host '%s'"), *Host);
+        return 1;
+    }
+
+    FSocket* Socket = FUdpSocketBuilder(TEXT("RenderStreamDmxSend")).WithBroadcast().Build();
+    if (!Socket)
+    {
+        UE_LOG(LogRenderStreamDmxSend, Error, TEXT("Unable to create a UDP socket"));
+        return 1;
+    }
+
+    UE_LOG(LogRenderStreamDmxSend, Display, TEXT("Sending %s universes %d-%d to %s:%d at %.1f Hz"),
+        bSACN ? TEXT("sACN") : TEXT("Art-Net"), FirstUniverse, FirstUniverse + NumUniverses - 1, *Host, Port, Rate);
+
+    uint8 Levels[RenderStreamDmx::UniverseSize];
+    TArray<uint8> Packet;
+    const double Interval = 1.0 / FMath::Max(Rate, 1.f);
+    double NextTime = FPlatformTime::Seconds();
+    for (int32 i = 0; (Count <= 0 || i < Count) && !IsEngineExitRequested(); ++i)
+    {
+        // A ramp offset per channel, so 16-bit parameters see both their bytes change.
+        for (int32 Channel = 0; Channel < RenderStreamDmx::UniverseSize; ++Channel)
+            Levels[Channel] = uint8(Value >= 0 ? Value : i + Channel);
+
+        for (int32 Universe = FirstUniverse; Universe < FirstUniverse + NumUniverses; ++Universe)
+        {
+            if (bSACN)
+                RenderStreamDmx::BuildSACN(Packet, Universe, uint8(i), Levels, RenderStreamDmx::UniverseSize);
+            else
+                RenderStreamDmx::BuildArtDmx(Packet, Universe, uint8(i), Levels, RenderStreamDmx::UniverseSize);
+            int32 Sent = 0;
+            if (!Socket->SendTo(Packet.GetData(), Packet.Num(), Sent, *Address))
+                UE_LOG(LogRenderStreamDmxSend, Warning, TEXT("Failed to send universe %d"), Universe);
+        }
+
+        if (i % FMath::Max(int32(Rate), 1) == 0)
+            UE_LOG(LogRenderStreamDmxSend, Display, TEXT("Sent %d frames"), i + 1);
+
+        NextTime += Interval;
+        const double Remaining = NextTime - FPlatformTime::Seconds();
+        if (Remaining > 0)
+            FPlatformProcess::Sleep(float(Remaining));
+    }
+
+    Socket->Close();
+    SocketSubsystem->DestroySocket(Socket);
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include "RenderStreamFakeBackend.h"
+
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+    using RS_ERROR = RenderStreamLink::RS_ERROR;
+
+    struct FFakeState
+    {
+        RenderStreamFakeBackend::FConfig Config;
+        std::vector<std::string> StreamNames;
+        std::string Channel = "Benchmark";
+        uint64 FrameIndex = 0;
+        double CurrentTracked = 0;
+
+        FCriticalSection Lock; // guards everything below, sends come from the render thread
+        TMap<double, double> AwaitedAt; // tTracked -> FPlatformTime::Seconds() when handed out
+        TArray<double> Latencies;
+        uint64 SentFrames = 0;
+    };
+
+    FFakeState& State()
+    {
+        static FFakeState State;
+        return State;
+    }
+
+    // Frames older than this are no longer expected to be sent.
+    static constexpr int32 MaxAwaitedFrames = 64;
+
+    void fake_registerLoggingFunc(RenderStreamLink::logger_t) {}
+    void fake_unregisterLoggingFunc() {}
+    RS_ERROR fake_initialise(int, int) { return RenderStreamLink::RS_ERROR_SUCCESS; }
+    RS_ERROR fake_shutdown() { return RenderStreamLink::RS_ERROR_SUCCESS; }
+    RS_ERROR fake_setSchema(RenderStreamLink::Schema*) { return RenderStreamLink::RS_ERROR_SUCCESS; }
+    RS_ERROR fake_saveSchema(const char*, RenderStreamLink::Schema*) { return RenderStreamLink::RS_ERROR_SUCCESS; }
+    RS_ERROR fake_setFollower(int) { return RenderStreamLink::RS_ERROR_SUCCESS; }
+    RS_ERROR fake_beginFollowerFrame(double) { return RenderStreamLink::RS_ERROR_SUCCESS; }
+    RS_ERROR fake_logToD3(const char*) { return RenderStreamLink::RS_ERROR_SUCCESS; }
+    RS_ERROR fake_sendProfilingData(RenderStreamLink::ProfilingEntry*, int) { return RenderStreamLink::RS_ERROR_SUCCESS; }
+    RS_ERROR fake_setNewStatusMessage(const char*) { return RenderStreamLink::RS_ERROR_SUCCESS; }
+
+    RS_ERROR fake_loadSchema(const char*, RenderStreamLink::Schema* schema, uint32_t* nBytes)
+    {
+        if (!schema || *nBytes < sizeof(RenderStreamLink::Schema))
+        {
+            *nBytes = sizeof(RenderStreamLink::Schema);
+            return RenderStreamLink::RS_ERROR_BUFFER_OVERFLOW;
+        }
+
+        // The configured schema is shared rather than packed into the buffer, an empty one lets the project 'just work'.
+        if (const RenderStreamLink::Schema* Configured = State().Config.Schema)
+            *schema = *Configured;
+        else
+            FMemory::Memzero(*schema);
+        return RenderStreamLink::RS_ERROR_SUCCESS;
+    }
+
+    RS_ERROR fake_getStreams(RenderStreamLink::StreamDescriptions* streams, uint32_t* nBytes)
+    {
+        FFakeState& S = State();
+        const uint32_t Required = sizeof(RenderStreamLink::StreamDescriptions) + S.StreamNames.size() * sizeof(RenderStreamLink::StreamDescription);
+        if (!streams || *nBytes < Required)
+        {
+            *nBytes = Required;
+            return RenderStreamLink::RS_ERROR_BUFFER_OVERFLOW;
+        }
+
+        // Strings point into the backend's state, which outlives the descriptions.
+        streams->nStreams = uint32_t(S.StreamNames.size());
+        streams->streams = reinterpret_cast<RenderStreamLink::StreamDescription*>(streams + 1);
+        for (uint32_t i = 0; i < streams->nStreams; ++i)
+        {
+            RenderStreamLink::StreamDescription& Description = streams->streams[i];
+            Description.handle = i + 1;
+            Description.channel = S.Channel.c_str();
+            Description.name = S.StreamNames[i].c_str();
+            Description.width = S.Config.Resolution.X;
+            Description.height = S.Config.Resolution.Y;
+            Description.format = S.Config.Format;
+            Description.clipping = { 0.f, 1.f, 0.f, 1.f };
+        }
+        *nBytes = Required;
+        return RenderStreamLink::RS_ERROR_SUCCESS;
+    }
+
+    RS_ERROR fake_awaitFrameData(int, RenderStreamLink::FrameData* data)
+    {
+        FFakeState& S = State();
+        ++S.FrameIndex;
+        S.CurrentTracked = double(S.FrameIndex) * S.Config.FrameRateDenominator / S.Config.FrameRateNumerator;
+
+        data->tTracked = S.CurrentTracked;
+        data->localTime = S.CurrentTracked;
+        data->localTimeDelta = double(S.Config.FrameRateDenominator) / S.Config.FrameRateNumerator;
+        data->frameRateNumerator = S.Config.FrameRateNumerator;
+        data->frameRateDenominator = S.Config.FrameRateDenominator;
+        data->flags = RenderStreamLink::FRAMEDATA_NO_FLAGS;
+        data->scene = 0;
+
+        FScopeLock Lock(&S.Lock);
+        S.AwaitedAt.Add(S.CurrentTracked, FPlatformTime::Seconds());
+        if (S.AwaitedAt.Num() > MaxAwaitedFrames)
+        {
+            const double Oldest = S.CurrentTracked - double(MaxAwaitedFrames) * S.Config.FrameRateDenominator / S.Config.FrameRateNumerator;
+            for (auto It = S.AwaitedAt.CreateIterator(); It; ++It)
+            {
+                if (It.Key() <= Oldest)
+                    It.RemoveCurrent();
+            }
+        }
+        return RenderStreamLink::RS_ERROR_SUCCESS;
+    }
+
+    RS_ERROR fake_getFrameParameters(uint64_t, void* outParameterData, size_t outParameterDataSize)
+    {
+        FMemory::Memzero(outParameterData, outParameterDataSize);
+        return RenderStreamLink::RS_ERROR_SUCCESS;
+    }
+
+    RS_ERROR fake_getFrameCamera(RenderStreamLink::StreamHandle streamHandle, RenderStreamLink::CameraData* outCameraData)
+    {
+        FMemory::Memzero(*outCameraData);
+        outCameraData->id = streamHandle;
+        outCameraData->cameraHandle = streamHandle; // non-zero, every stream is requested
+        outCameraData->focalLength = 30.f;
+        outCameraData->sensorX = 36.f;
+        outCameraData->sensorY = 24.f;
+        outCameraData->nearZ = 0.1f;
+        outCameraData->farZ = 1000.f;
+        return RenderStreamLink::RS_ERROR_SUCCESS;
+    }
+
+    RS_ERROR fake_sendFrame(RenderStreamLink::StreamHandle, RenderStreamLink::SenderFrameType, RenderStreamLink::SenderFrameTypeData, const RenderStreamLink::CameraResponseData* sendData)
+    {
+        FFakeState& S = State();
+        const double Now = FPlatformTime::Seconds();
+        FScopeLock Lock(&S.Lock);
+        ++S.SentFrames;
+        if (const double* AwaitedAt = S.AwaitedAt.Find(sendData->tTracked))
+            S.Latencies.Add((Now - *AwaitedAt) * 1000.0);
+        return RenderStreamLink::RS_ERROR_SUCCESS;
+    }
+}
+
+void RenderStreamFakeBackend::Configure(const FConfig& Config)
+{
+    FFakeState& S = State();
+    S.Config = Config;
+    S.StreamNames.clear();
+    for (int32 i = 0; i < Config.NumStreams; ++i)
+        S.StreamNames.push_back("Benchmark" + std::to_string(i));
+    S.FrameIndex = 0;
+
+    FScopeLock Lock(&S.Lock);
+    S.AwaitedAt.Reset();
+    S.Latencies.Reset();
+    S.SentFrames = 0;
+}
+
+TArray<double> RenderStreamFakeBackend::TakeSendLatencies()
+{
+    FFakeState& S = State();
+    FScopeLock Lock(&S.Lock);
+    return MoveTemp(S.Latencies);
+}
+
+uint64 RenderStreamFakeBackend::NumSentFrames()
+{
+    FFakeState& S = State();
+    FScopeLock Lock(&S.Lock);
+    return S.SentFrames;
+}
+
+bool RenderStreamLink::loadFake()
+{
+    unloadExplicit();
+
+    rs_initialise = &fake_initialise;
+    rs_shutdown = &fake_shutdown;
+
+    rs_registerLoggingFunc = &fake_registerLoggingFunc;
+    rs_registerErrorLoggingFunc = &fake_registerLoggingFunc;
+    rs_registerVerboseLoggingFunc = &fake_registerLoggingFunc;
+
+    rs_unregisterLoggingFunc = &fake_unregisterLoggingFunc;
+    rs_unregisterErrorLoggingFunc = &fake_unregisterLoggingFunc;
+    rs_unregisterVerboseLoggingFunc = &fake_unregisterLoggingFunc;
+
+    rs_setSchema = &fake_setSchema;
+    rs_saveSchema = &fake_saveSchema;
+    rs_loadSchema = &fake_loadSchema;
+
+    rs_getStreams = &fake_getStreams;
+
+    rs_sendFrame = &fake_sendFrame;
+    rs_setFollower = &fake_setFollower;
+    rs_beginFollowerFrame = &fake_beginFollowerFrame;
+    rs_awaitFrameData = &fake_awaitFrameData;
+    rs_getFrameParameters = &fake_getFrameParameters;
+    rs_getFrameCamera = &fake_getFrameCamera;
+
+    rs_logToD3 = &fake_logToD3;
+    rs_sendProfilingData = &fake_sendProfilingData;
+    rs_setNewStatusMessage = &fake_setNewStatusMessage;
+
+    m_fake = true;
+    m_loaded = true;
+    return isAvailable();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderStreamLink.h"
+
+// In-process stand-in for d3renderstream.dll, used to drive the plugin without d3 from the benchmark commandlets.
+// Frames are handed out as soon as they are awaited and every stream is requested every frame.
+namespace RenderStreamFakeBackend
+{
+    struct FConfig
+    {
+        int32 NumStreams = 4;
+        FIntPoint Resolution = { 1920, 1080 };
+        RenderStreamLink::RSPixelFormat Format = RenderStreamLink::RS_FMT_BGRA8;
+        uint32 FrameRateNumerator = 60;
+        uint32 FrameRateDenominator = 1;
+        // Served by rs_loadSchema, which serves an empty schema when null. Must outlive the backend.
+        const RenderStreamLink::Schema* Schema = nullptr;
+    };
+
+    // Takes effect on the next RenderStreamLink::loadFake.
+    void Configure(const FConfig& Config);
+
+    // Milliseconds from rs_awaitFrameData handing out a frame to rs_sendFrame sending it, one entry per sent stream.
+    // Returns and clears the latencies collected so far.
+    TArray<double> TakeSendLatencies();
+    uint64 NumSentFrames();
+}
@@ -34,7 +34,7 @@ namespace {
 
 RenderStreamLink::RenderStreamLink()
 {
-    loadExplicit();
+    // Loaded explicitly, FRenderStreamModule::StartupModule does so in the background.
 }
 
 RenderStreamLink::~RenderStreamLink()
@@ -44,7 +44,7 @@ RenderStreamLink::~RenderStreamLink()
 
 bool RenderStreamLink::isAvailable()
 {
-    return m_dll && m_loaded;
+    return (m_dll || m_fake) && m_loaded;
 }
 
 bool RenderStreamLink::loadExplicit()
@@ -202,5 +202,6 @@ bool RenderStreamLink::unloadExplicit()
         FreeLibrary((HMODULE)m_dll);
     m_dll = nullptr;
 #endif
+    m_fake = false;
     return m_dll == nullptr;
 }
@@ -0,0 +1,191 @@
+#include "RenderStreamLogOutputDevice.h"
+
+#include "RenderStreamLink.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+// Messages waiting beyond this are dropped, bounding memory during a log storm.
+static constexpr int32 MaxQueuedMessages = 4096;
+// A batch is sent once it reaches this size, or once the queue is drained.
+static constexpr size_t MaxBatchBytes = 16 * 1024;
+// How long the forwarder sleeps when nothing wakes it.
+static constexpr uint32 ForwardIntervalMs = 50;
+
+FRenderStreamLogOutputDevice::FRenderStreamLogOutputDevice()
+{
+    m_batch.reserve(MaxBatchBytes);
+    m_wake = FPlatformProcess::GetSynchEventFromPool(false);
+    m_thread = FRunnableThread::Create(this, TEXT("RenderStreamLogForwarder"), 0, TPri_BelowNormal);
+
+    check(GLog);
+    GLog->AddOutputDevice(this);
+}
+
+FRenderStreamLogOutputDevice::~FRenderStreamLogOutputDevice()
+{
+    if (GLog != nullptr)
+    {
+        GLog->RemoveOutputDevice(this);
+    }
+    TearDown();
+}
+
+void FRenderStreamLogOutputDevice::SetVerbosity(ELogVerbosity::Type DefaultVerbosity, const TMap<FName, ELogVerbosity::Type>& CategoryVerbosity)
+{
+    FScopeLock Lock(&m_filterLock);
+    m_defaultVerbosity = DefaultVerbosity;
+    m_categoryVerbosity = CategoryVerbosity;
+
+    int32 MaxVerbosity = DefaultVerbosity;
+    for (const auto& It : CategoryVerbosity)
+        MaxVerbosity = FMath::Max<int32>(MaxVerbosity, It.Value);
+    m_maxVerbosity.store(MaxVerbosity, std::memory_order_relaxed);
+}
+
+void FRenderStreamLogOutputDevice::SetRateLimit(int32 MessagesPerSecond)
+{
+    m_rateLimit.store(FMath::Max(MessagesPerSecond, 1), std::memory_order_relaxed);
+}
+
+void FRenderStreamLogOutputDevice::Activate()
+{
+    m_active.store(true, std::memory_order_release);
+    m_wake->Trigger();
+}
+
+void FRenderStreamLogOutputDevice::Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const class FName& Category)
+{
+    // Runs on whichever thread logged, keep it to a filter and an enqueue.
+    const ELogVerbosity::Type Level = ELogVerbosity::Type(Verbosity & ELogVerbosity::VerbosityMask);
+    if (Level > m_maxVerbosity.load(std::memory_order_relaxed) || m_stop.load(std::memory_order_relaxed))
+        return;
+
+    const int32 Queued = m_queued.fetch_add(1, std::memory_order_relaxed);
+    if (Queued >= MaxQueuedMessages)
+    {
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        m_droppedQueueFull.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_queue.Enqueue({ Category, Level, FString(Message) });
+
+    // The forwarder polls anyway, only wake it for the start of a burst or for errors.
+    if (Queued == 0 || Level <= ELogVerbosity::Error)
+        m_wake->Trigger();
+}
+
+void FRenderStreamLogOutputDevice::Flush()
+{
+    // Never block here, this is also called while panicking and the forwarder may be the thread which crashed.
+    if (m_consumerLock.TryLock())
+    {
+        Forward();
+        m_consumerLock.Unlock();
+    }
+}
+
+void FRenderStreamLogOutputDevice::TearDown()
+{
+    if (m_tornDown)
+        return;
+    m_tornDown = true;
+
+    if (m_thread)
+    {
+        m_thread->Kill(true);
+        delete m_thread;
+        m_thread = nullptr;
+    }
+
+    // Forward whatever the thread did not get to.
+    Flush();
+
+    FPlatformProcess::ReturnSynchEventToPool(m_wake);
+    m_wake = nullptr;
+}
+
+uint32 FRenderStreamLogOutputDevice::Run()
+{
+    while (!m_stop.load(std::memory_order_relaxed))
+    {
+        m_wake->Wait(ForwardIntervalMs);
+
+        FScopeLock Lock(&m_consumerLock);
+        Forward();
+    }
+    return 0;
+}
+
+void FRenderStreamLogOutputDevice::Stop()
+{
+    m_stop.store(true, std::memory_order_relaxed);
+    m_wake->Trigger();
+}
+
+void FRenderStreamLogOutputDevice::Forward()
+{
+    // Keep the queue until the library is loaded, it is bounded so this can't grow if loading fails.
+    if (!m_active.load(std::memory_order_acquire))
+        return;
+
+    const bool Available = RenderStreamLink::instance().isAvailable();
+    const int32 RateLimit = m_rateLimit.load(std::memory_order_relaxed);
+
+    FScopeLock FilterLock(&m_filterLock);
+    FEntry Entry;
+    while (m_queue.Dequeue(Entry))
+    {
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+        const ELogVerbosity::Type* CategoryVerbosity = m_categoryVerbosity.Find(Entry.Category);
+        if (!Available || Entry.Verbosity > (CategoryVerbosity ? *CategoryVerbosity : m_defaultVerbosity))
+            continue;
+
+        const double Now = FPlatformTime::Seconds();
+        if (Now - m_rateWindowStart >= 1.0)
+        {
+            m_rateWindowStart = Now;
+            m_rateWindowCount = 0;
+        }
+        if (m_rateWindowCount >= RateLimit)
+        {
+            m_droppedRateLimited.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        ++m_rateWindowCount;
+
+        m_batch.append(TCHAR_TO_ANSI(*Entry.Category.ToString()));
+        m_batch.append(": ");
+        m_batch.append(TCHAR_TO_ANSI(*Entry.Message));
+        m_batch.append("\n");
+        m_forwarded.fetch_add(1, std::memory_order_relaxed);
+
+        if (m_batch.size() >= MaxBatchBytes)
+            SendBatch();
+    }
+
+    // Let d3 know messages are missing, at most once per rate window.
+    const uint64 Dropped = DroppedMessages();
+    if (Available && Dropped != m_reportedDrops && m_rateWindowCount < RateLimit && m_reportedDropsWindow != m_rateWindowStart)
+    {
+        m_batch.append(TCHAR_TO_ANSI(*FString::Printf(TEXT("LogRenderStream: %llu log messages dropped while forwarding to d3\n"), Dropped - m_reportedDrops)));
+        m_reportedDrops = Dropped;
+        m_reportedDropsWindow = m_rateWindowStart;
+        ++m_rateWindowCount; // the notice counts as one message
+    }
+
+    SendBatch();
+}
+
+void FRenderStreamLogOutputDevice::SendBatch()
+{
+    if (m_batch.empty())
+        return;
+
+    RenderStreamLink::instance().rs_logToD3(m_batch.c_str());
+    m_batch.clear();
+}
@@ -0,0 +1,90 @@
+#include "RenderStreamMemory.h"
+
+#include "RenderStream.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemStats.h"
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+DECLARE_LLM_MEMORY_STAT(TEXT("RenderStream"), STAT_RenderStreamLLM, STATGROUP_LLM);
+DECLARE_LLM_MEMORY_STAT(TEXT("RS Streams"), STAT_RenderStreamLLMStreams, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("RS Schema"), STAT_RenderStreamLLMSchema, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("RS Responses"), STAT_RenderStreamLLMResponses, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("RS Cameras"), STAT_RenderStreamLLMCameras, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("RS Scenes"), STAT_RenderStreamLLMScenes, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("RS Diagnostics"), STAT_RenderStreamLLMDiagnostics, STATGROUP_LLMFULL);
+
+// Project tags are shared with the project the plugin is in, which numbers its own from the start of the range.
+static constexpr int32 FirstTag = int32(ELLMTag::ProjectTagStart) + 64;
+static_assert(FirstTag + int32(ERenderStreamMemory::Num) <= int32(ELLMTag::ProjectTagEnd), "RenderStream LLM tags out of the project range");
+
+ELLMTag RenderStreamLLMTag(ERenderStreamMemory Category)
+{
+    return ELLMTag(FirstTag + int32(Category));
+}
+#endif
+
+const TCHAR* RenderStreamMemoryName(ERenderStreamMemory Category)
+{
+    switch (Category)
+    {
+    case ERenderStreamMemory::Streams: return TEXT("Streams");
+    case ERenderStreamMemory::Schema: return TEXT("Schema");
+    case ERenderStreamMemory::Responses: return TEXT("Responses");
+    case ERenderStreamMemory::Cameras: return TEXT("Cameras");
+    case ERenderStreamMemory::Scenes: return TEXT("Scenes");
+    case ERenderStreamMemory::Diagnostics: return TEXT("Diagnostics");
+    default: return TEXT("Unknown");
+    }
+}
+
+void RegisterRenderStreamLLMTags()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    const FName StatNames[] = {
+        GET_STATFNAME(STAT_RenderStreamLLMStreams),
+        GET_STATFNAME(STAT_RenderStreamLLMSchema),
+        GET_STATFNAME(STAT_RenderStreamLLMResponses),
+        GET_STATFNAME(STAT_RenderStreamLLMCameras),
+        GET_STATFNAME(STAT_RenderStreamLLMScenes),
+        GET_STATFNAME(STAT_RenderStreamLLMDiagnostics),
+    };
+    static_assert(UE_ARRAY_COUNT(StatNames) == uint8(ERenderStreamMemory::Num), "A stat per category");
+
+    for (uint8 i = 0; i < uint8(ERenderStreamMemory::Num); ++i)
+    {
+        const FString Name = FString(TEXT("RS ")) + RenderStreamMemoryName(ERenderStreamMemory(i));
+        FLowLevelMemTracker::Get().RegisterProjectTag(FirstTag + i, *Name, StatNames[i], GET_STATFNAME(STAT_RenderStreamLLM));
+    }
+#endif
+}
+
+uint64 FRenderStreamMemoryUsage::TotalCPU() const
+{
+    uint64 Total = 0;
+    for (uint64 Bytes : CPU)
+        Total += Bytes;
+    return Total;
+}
+
+uint64 FRenderStreamMemoryUsage::TotalGPU() const
+{
+    uint64 Total = 0;
+    for (uint64 Bytes : GPU)
+        Total += Bytes;
+    return Total;
+}
+
+static FAutoConsoleCommand RenderStreamMemReport(
+    TEXT("rs.memreport"),
+    TEXT("Logs the CPU and GPU memory RenderStream uses per stream, per scene and per category."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        FRenderStreamModule* Module = FRenderStreamModule::Get();
+        if (!Module->StreamPool)
+        {
+            UE_LOG(LogRenderStream, Warning, TEXT("RenderStream is not running, there is no memory to report"));
+            return;
+        }
+        Module->MemReport();
+    }));
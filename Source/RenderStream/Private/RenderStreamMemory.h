@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// RenderStream's allocation categories. Each is an LLM tag under "RenderStream", so an LLM capture (-LLM, stat LLMFULL)
+// attributes the plugin's CPU memory, and rs.memreport lists the CPU and GPU memory of each.
+enum class ERenderStreamMemory : uint8
+{
+    Streams,     // stream textures, fences and timing queries
+    Schema,      // the loaded schema
+    Responses,   // camera responses queued per policy
+    Cameras,     // template camera instances
+    Scenes,      // levels loaded by the scene selector
+    Diagnostics, // trace, telemetry and DMX buffers
+    Num
+};
+
+const TCHAR* RenderStreamMemoryName(ERenderStreamMemory Category);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+ELLMTag RenderStreamLLMTag(ERenderStreamMemory Category);
+#define RS_LLM_SCOPE(Category) LLM_SCOPE(RenderStreamLLMTag(Category))
+#else
+#define RS_LLM_SCOPE(Category)
+#endif
+
+// Call before the module allocates anything, so its first allocations are tagged.
+void RegisterRenderStreamLLMTags();
+
+// Bytes per category. Cameras and scenes are estimated by walking their objects, which is only done on request.
+struct FRenderStreamMemoryUsage
+{
+    uint64 CPU[uint8(ERenderStreamMemory::Num)] = {};
+    uint64 GPU[uint8(ERenderStreamMemory::Num)] = {};
+
+    uint64 TotalCPU() const;
+    uint64 TotalGPU() const;
+};
@@ -0,0 +1,290 @@
+#include "RenderStreamMicrobenchmarkCommandlet.h"
+
+#include "RenderStream.h"
+#include "RenderStreamBenchmarkStats.h"
+#include "RenderStreamFakeBackend.h"
+#include "RenderStreamSceneSelector.h"
+#include "RenderStreamSchemaBuilder.h"
+#include "RenderStreamChannelDefinition.h"
+#include "StreamPool.h"
+#include "FrameStream.h"
+#include "SyncFrameData.h"
+
+#include "Camera/CameraActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UnrealType.h"
+
+#include <string>
+
+DEFINE_LOG_CATEGORY_STATIC(LogRenderStreamMicrobenchmark, Log, All);
+
+using namespace RenderStreamBenchmark;
+
+namespace {
+    // Exposes the scene selector's parameter paths for a single root actor.
+    class FBenchmarkSceneSelector : public RenderStreamSceneSelector
+    {
+    public:
+        AActor* Root = nullptr;
+
+        void ApplyScene(const UWorld& World, uint32_t SceneId) override { ApplyParameters(SceneId, { Root }); }
+        bool Validate() const { return ValidateParameters(Schema().scenes.scenes[0], { Root }); }
+
+    protected:
+        bool OnLoadedSchema(const UWorld& World, const RenderStreamLink::Schema& Schema) override { return true; }
+    };
+
+    // An actor class with Count exposed float properties, built at runtime so the parameter count can be varied.
+    UClass* MakeParameterClass(int32 Count)
+    {
+        UClass* Class = NewObject<UClass>(GetTransientPackage(), *FString::Printf(TEXT("RenderStreamBenchmarkActor%d"), Count), RF_Transient);
+        Class->SetSuperStruct(AActor::StaticClass());
+        Class->ClassFlags |= CLASS_Transient;
+        // AddCppProperty prepends, add in reverse to keep the schema order.
+        for (int32 i = Count - 1; i >= 0; --i)
+        {
+            FFloatProperty* Property = new FFloatProperty(Class, *FString::Printf(TEXT("Parameter%d"), i), RF_Public);
+            Property->SetPropertyFlags(CPF_Edit | CPF_BlueprintVisible);
+            Class->AddCppProperty(Property);
+        }
+        Class->Bind();
+        Class->StaticLink(true);
+        Class->AssembleReferenceTokenStream();
+        return Class;
+    }
+
+    // Builds the schema the way the editor module does, with a float parameter per property of MakeParameterClass.
+    RenderStreamLink::ScopedSchema BuildSchema(int32 NumScenes, int32 NumParameters)
+    {
+        FRenderStreamSchemaBuilder Builder;
+        Builder.AddChannel("Benchmark");
+        for (int32 i = 0; i < NumScenes; ++i)
+        {
+            Builder.AddScene(TCHAR_TO_UTF8(*FString::Printf(TEXT("Scene%d"), i)));
+            for (int32 j = 0; j < NumParameters; ++j)
+            {
+                const std::string Key = TCHAR_TO_UTF8(*FString::Printf(TEXT("Parameter%d"), j));
+                Builder.AddParameter("Benchmark", Key.c_str(), Key.c_str(), 0.f, 1.f, 0.01f, 0.f, -1, 2);
+            }
+        }
+        return Builder.Build();
+    }
+
+    struct FRunSettings
+    {
+        int32 Warmup = 100;
+        int32 Repetitions = 50;
+        FString Filter;
+    };
+
+    // Times Repetitions batches of BatchSize calls after the warm-up, each sample is the per-call time in microseconds.
+    FSummary Measure(const FRunSettings& Settings, int32 BatchSize, TFunctionRef<void()> Body)
+    {
+        for (int32 i = 0; i < Settings.Warmup; ++i)
+            Body();
+
+        TArray<double> Samples;
+        Samples.Reserve(Settings.Repetitions);
+        for (int32 Repetition = 0; Repetition < Settings.Repetitions; ++Repetition)
+        {
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            for (int32 i = 0; i < BatchSize; ++i)
+                Body();
+            Samples.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / BatchSize);
+        }
+        return Summarise(MoveTemp(Samples));
+    }
+}
+
+URenderStreamMicrobenchmarkCommandlet::URenderStreamMicrobenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 URenderStreamMicrobenchmarkCommandlet::Main(const FString& Params)
+{
+    FRunSettings Settings;
+    FParse::Value(*Params, TEXT("Warmup="), Settings.Warmup);
+    FParse::Value(*Params, TEXT("Repetitions="), Settings.Repetitions);
+    FParse::Value(*Params, TEXT("Filter="), Settings.Filter);
+    FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RenderStream"), TEXT("Microbenchmark.json"));
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    if (Settings.Repetitions < 1)
+    {
+        UE_LOG(LogRenderStreamMicrobenchmark, Error, TEXT("Invalid number of repetitions %d"), Settings.Repetitions);
+        return 1;
+    }
+
+    RenderStreamFakeBackend::FConfig Config;
+    RenderStreamFakeBackend::Configure(Config);
+    if (!RenderStreamLink::instance().loadFake())
+    {
+        UE_LOG(LogRenderStreamMicrobenchmark, Error, TEXT("Unable to load the fake RenderStream backend"));
+        return 1;
+    }
+
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("RenderStreamMicrobenchmark"));
+
+    // Schema validation logs every property it sees, keep that out of the timings and the console.
+    const ELogVerbosity::Type PreviousVerbosity = LogRenderStream.GetVerbosity();
+    LogRenderStream.SetVerbosity(ELogVerbosity::Warning);
+    ON_SCOPE_EXIT
+    {
+        LogRenderStream.SetVerbosity(PreviousVerbosity);
+        World->DestroyWorld(false);
+        RenderStreamLink::instance().unloadExplicit();
+    };
+
+    TSharedRef<FJsonObject> Cases = MakeShared<FJsonObject>();
+    auto Run = [&Settings, &Cases](const FString& Name, int32 BatchSize, TFunctionRef<void()> Body)
+    {
+        if (!Settings.Filter.IsEmpty() && !Name.Contains(Settings.Filter))
+            return;
+
+        const FSummary Summary = Measure(Settings, BatchSize, Body);
+        Cases->SetObjectField(Name, ToJson(Summary));
+        UE_LOG(LogRenderStreamMicrobenchmark, Display, TEXT("%-48s p50 %10.3fus  mean %10.3fus  stddev %8.3fus  min %10.3fus  max %10.3fus"),
+            *Name, Summary.P50, Summary.Mean, Summary.StdDev, Summary.Min, Summary.Max);
+    };
+
+    // Sync frame data, mapped and string coded once per frame for nDisplay.
+    {
+        FRenderStreamSyncFrameData Data;
+        Data.m_frameDataValid = true;
+        TArray<uint8> Bytes;
+        Run(TEXT("SyncFrameData.Map.Save"), 1000, [&Data, &Bytes]()
+        {
+            Bytes.Reset();
+            FMemoryWriter Ar(Bytes, /*bIsPersistent=*/ true);
+            Data.Map(Ar);
+        });
+        Run(TEXT("SyncFrameData.Map.Load"), 1000, [&Data, &Bytes]()
+        {
+            FMemoryReader Ar(Bytes);
+            Data.Map(Ar);
+        });
+
+        const FString Encoded = Data.SerializeToString();
+        Run(TEXT("SyncFrameData.Encode"), 1000, [&Data]()
+        {
+            verify(!Data.SerializeToString().IsEmpty());
+        });
+        // DeserializeFromString without the follower apply which follows it.
+        Run(TEXT("SyncFrameData.Decode"), 1000, [&Data, &Encoded]()
+        {
+            TArray<uint8> TempBytes;
+            TempBytes.AddUninitialized(Encoded.Len());
+            StringToBytes(Encoded, TempBytes.GetData(), Encoded.Len());
+            FMemoryReader Ar(TempBytes);
+            Data.Map(Ar);
+        });
+    }
+
+    // Scene parameters, validated on schema load and applied every frame.
+    for (int32 NumParameters : { 8, 64, 512 })
+    {
+        UClass* Class = MakeParameterClass(NumParameters);
+        AActor* Actor = NewObject<AActor>(World->PersistentLevel, Class, NAME_None, RF_Transient);
+
+        RenderStreamLink::ScopedSchema Schema = BuildSchema(1, NumParameters);
+        Config.Schema = &Schema.schema;
+        RenderStreamFakeBackend::Configure(Config);
+
+        FBenchmarkSceneSelector Selector;
+        Selector.Root = Actor;
+        Selector.LoadSchemas(*World);
+        if (!Selector.Validate())
+        {
+            UE_LOG(LogRenderStreamMicrobenchmark, Error, TEXT("Generated schema with %d parameters failed validation"), NumParameters);
+            return 1;
+        }
+
+        Run(FString::Printf(TEXT("SceneSelector.ValidateParameters/%d"), NumParameters), 10, [&Selector]() { Selector.Validate(); });
+        Run(FString::Printf(TEXT("SceneSelector.ApplyParameters/%d"), NumParameters), 100, [&Selector, World]() { Selector.ApplyScene(*World, 0); });
+
+        Config.Schema = nullptr;
+        RenderStreamFakeBackend::Configure(Config);
+    }
+
+    // Stream lookups by name, done per policy per frame. The last stream is the worst case of the linear search.
+    for (int32 NumStreams : { 4, 16, 64 })
+    {
+        FStreamPool Pool;
+        FString LastName;
+        for (int32 i = 0; i < NumStreams; ++i)
+        {
+            TSharedPtr<FFrameStream> Stream = MakeShared<FFrameStream>();
+            LastName = FString::Printf(TEXT("Benchmark%d"), i);
+            Stream->SetupHeadless(LastName, { 1920, 1080 }, TEXT("Benchmark"), { 0.f, 1.f, 0.f, 1.f }, i + 1);
+            Pool.AddStreamToPool(Stream);
+        }
+
+        Run(FString::Printf(TEXT("StreamPool.GetStream/%d"), NumStreams), 1000, [&Pool, &LastName]()
+        {
+            verify(Pool.GetStream(LastName));
+        });
+    }
+
+    // Schema construction and teardown, as done by the editor on every save.
+    for (const FIntPoint& Size : { FIntPoint(1, 64), FIntPoint(16, 64), FIntPoint(16, 512) })
+    {
+        Run(FString::Printf(TEXT("ScopedSchema.BuildAndReset/%dx%d"), Size.X, Size.Y), 10, [Size]()
+        {
+            RenderStreamLink::ScopedSchema Schema = BuildSchema(Size.X, Size.Y);
+        });
+    }
+
+    // The visibility set FinalizeViewFamily builds for every view of a channel with filtered actors.
+    for (int32 NumActors : { 16, 256 })
+    {
+        static constexpr int32 PrimitivesPerActor = 4;
+        ACameraActor* Camera = NewObject<ACameraActor>(World->PersistentLevel, NAME_None, RF_Transient);
+        URenderStreamChannelDefinition* Definition = NewObject<URenderStreamChannelDefinition>(Camera, NAME_None, RF_Transient);
+        for (int32 i = 0; i < NumActors; ++i)
+        {
+            AActor* Actor = NewObject<AActor>(World->PersistentLevel, NAME_None, RF_Transient);
+            for (int32 j = 0; j < PrimitivesPerActor; ++j)
+                NewObject<UStaticMeshComponent>(Actor, NAME_None, RF_Transient);
+            Definition->Hidden.Add(Actor);
+        }
+
+        Run(FString::Printf(TEXT("ChannelDefinition.GetFilteredPrimitives/%d"), NumActors * PrimitivesPerActor), 100, [Definition]()
+        {
+            TSet<FPrimitiveComponentId> Collection;
+            Definition->GetFilteredPrimitives(Collection);
+        });
+    }
+
+    TSharedRef<FJsonObject> Results = MakeShared<FJsonObject>();
+    {
+        TSharedRef<FJsonObject> JsonConfig = MakeShared<FJsonObject>();
+        JsonConfig->SetNumberField(TEXT("Warmup"), Settings.Warmup);
+        JsonConfig->SetNumberField(TEXT("Repetitions"), Settings.Repetitions);
+        Results->SetObjectField(TEXT("Config"), JsonConfig);
+        // Per-call microseconds.
+        Results->SetObjectField(TEXT("Cases"), Cases);
+    }
+
+    FString Output;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+    FJsonSerializer::Serialize(Results, Writer);
+    if (!FFileHelper::SaveStringToFile(Output, *OutputPath))
+    {
+        UE_LOG(LogRenderStreamMicrobenchmark, Error, TEXT("Unable to write the results to '%s'"), *OutputPath);
+        return 1;
+    }
+    UE_LOG(LogRenderStreamMicrobenchmark, Display, TEXT("Results written to '%s'"), *OutputPath);
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include "RenderStreamMonitor.h"
+
+#include "RenderStreamLink.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "ShaderCompiler.h"
+#include "ShaderPipelineCache.h"
+#include "UObject/UObjectGlobals.h"
+
+// Changes arriving faster than this are coalesced into one update.
+static constexpr double MinSendInterval = 0.25;
+// How often a status which could not be sent yet is retried.
+static constexpr double RetryInterval = 1.0;
+
+FRenderStreamMonitor::~FRenderStreamMonitor()
+{
+    if (m_thread)
+        Close();
+}
+
+void FRenderStreamMonitor::Open()
+{
+    if (m_thread)
+        return;
+
+    m_stop = false;
+    m_wake = FPlatformProcess::GetSynchEventFromPool(false);
+    {
+        // Send the status set before the monitor opened.
+        FScopeLock Lock(&m_lock);
+        if (m_dirty)
+            m_wake->Trigger();
+    }
+    m_thread = FRunnableThread::Create(this, TEXT("RenderStreamMonitor"));
+}
+
+void FRenderStreamMonitor::Close()
+{
+    if (!m_thread)
+        return;
+
+    m_thread->Kill(true);
+    delete m_thread;
+    m_thread = nullptr;
+
+    FPlatformProcess::ReturnSynchEventToPool(m_wake);
+    m_wake = nullptr;
+}
+
+void FRenderStreamMonitor::SetStatus(ERenderStreamStatusSource Source, const FString& Message)
+{
+    FScopeLock Lock(&m_lock);
+    FString& Status = m_status[uint8(Source)];
+    if (Status == Message)
+        return;
+
+    Status = Message;
+    m_dirty = true;
+    if (m_wake)
+        m_wake->Trigger();
+}
+
+FString FRenderStreamMonitor::GetStatus() const
+{
+    FScopeLock Lock(&m_lock);
+    return ComposeStatus();
+}
+
+void FRenderStreamMonitor::Poll()
+{
+    check(IsInGameThread());
+
+    const int32 ShaderJobs = GShaderCompilingManager && GShaderCompilingManager->IsCompiling() ? GShaderCompilingManager->GetNumRemainingJobs() : 0;
+    if (ShaderJobs != m_polledShaderJobs)
+    {
+        m_polledShaderJobs = ShaderJobs;
+        SetStatus(ERenderStreamStatusSource::ShaderCompilation, ShaderJobs ? FString::Printf(TEXT("Compiling %d Shaders"), ShaderJobs) : FString());
+    }
+
+    const uint32 Precompiles = FShaderPipelineCache::NumPrecompilesRemaining();
+    if (Precompiles != m_polledPrecompiles)
+    {
+        m_polledPrecompiles = Precompiles;
+        SetStatus(ERenderStreamStatusSource::PSOPrecompilation, Precompiles ? FString::Printf(TEXT("Precompiling %u PSOs"), Precompiles) : FString());
+    }
+
+    const int32 AsyncPackages = GetNumAsyncPackages();
+    if (AsyncPackages != m_polledAsyncPackages)
+    {
+        m_polledAsyncPackages = AsyncPackages;
+        SetStatus(ERenderStreamStatusSource::AsyncLoading, AsyncPackages ? FString::Printf(TEXT("Loading %d Packages"), AsyncPackages) : FString());
+    }
+}
+
+uint32 FRenderStreamMonitor::Run()
+{
+    bool Unsent = false;
+    while (!m_stop)
+    {
+        if (Unsent)
+            m_wake->Wait(FTimespan::FromSeconds(RetryInterval));
+        else
+            m_wake->Wait();
+
+        // Let a burst of changes settle, waking early only to stop.
+        double Remaining = m_lastSendTime + MinSendInterval - FPlatformTime::Seconds();
+        while (Remaining > 0 && !m_stop)
+        {
+            m_wake->Wait(FTimespan::FromSeconds(Remaining));
+            Remaining = m_lastSendTime + MinSendInterval - FPlatformTime::Seconds();
+        }
+
+        FString Status;
+        {
+            FScopeLock Lock(&m_lock);
+            if (!m_dirty)
+                continue;
+            m_dirty = false;
+            Status = ComposeStatus();
+        }
+
+        Unsent = Status != m_sent && !RenderStreamLink::instance().isAvailable();
+        if (Unsent)
+        {
+            // Stays dirty until the library is available to send it.
+            FScopeLock Lock(&m_lock);
+            m_dirty = true;
+        }
+        else if (Status != m_sent)
+        {
+            RenderStreamLink::instance().rs_setNewStatusMessage(TCHAR_TO_ANSI(*Status));
+            m_sent = Status;
+            m_lastSendTime = FPlatformTime::Seconds();
+        }
+    }
+
+    if (!m_sent.IsEmpty() && RenderStreamLink::instance().isAvailable())
+        RenderStreamLink::instance().rs_setNewStatusMessage("");
+    m_sent.Empty();
+    return 0;
+}
+
+void FRenderStreamMonitor::Stop()
+{
+    m_stop = true;
+    m_wake->Trigger();
+}
+
+FString FRenderStreamMonitor::ComposeStatus() const
+{
+    FString Status;
+    for (const FString& Message : m_status)
+    {
+        if (Message.IsEmpty())
+            continue;
+        if (!Status.IsEmpty())
+            Status += TEXT(", ");
+        Status += Message;
+    }
+    return Status;
+}
+
+FRenderStreamMonitor& RenderStreamMonitor()
+{
+    static FRenderStreamMonitor Monitor;
+    return Monitor;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+// Every active source is listed in d3's status message, in this order.
+enum class ERenderStreamStatusSource : uint8
+{
+    Stall,              // the watchdog found a stalled thread
+    Requests,           // d3 is not requesting frames
+    WarmUp,             // the stream pipeline is warming up
+    Streams,            // streams are being (re)configured
+    Loading,            // a scene selector is loading a level or map
+    AsyncLoading,       // packages are being loaded in the background
+    PSOPrecompilation,  // the pipeline cache is precompiling
+    ShaderCompilation,  // shaders are compiling
+    Num
+};
+
+// Aggregates the status of everything which keeps the project from rendering normally into d3's status message.
+// Sources push their status as it changes, the monitor thread sleeps until then and sends de-duplicated,
+// rate limited updates through rs_setNewStatusMessage.
+class FRenderStreamMonitor : public FRunnable
+{
+public:
+    virtual ~FRenderStreamMonitor();
+
+    void Open();
+    void Close();
+
+    // Thread safe, an empty message clears the source.
+    void SetStatus(ERenderStreamStatusSource Source, const FString& Message);
+    void ClearStatus(ERenderStreamStatusSource Source) { SetStatus(Source, FString()); }
+
+    // Samples the engine's polled sources, call once per frame on the game thread.
+    void Poll();
+
+    // Thread safe, the message as it is composed for d3, which may not have been sent yet.
+    FString GetStatus() const;
+
+private:
+    /** FRunnable implementation */
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+    FString ComposeStatus() const;
+
+    mutable FCriticalSection m_lock; // guards m_status and m_dirty
+    FString m_status[uint8(ERenderStreamStatusSource::Num)];
+    bool m_dirty = false;
+
+    // Last values seen by Poll, so the game thread only pushes changes.
+    int32 m_polledShaderJobs = 0;
+    uint32 m_polledPrecompiles = 0;
+    int32 m_polledAsyncPackages = 0;
+
+    FString m_sent;
+    double m_lastSendTime = 0;
+
+    FRunnableThread* m_thread = nullptr;
+    FEvent* m_wake = nullptr;
+    std::atomic<bool> m_stop { false };
+};
+
+FRenderStreamMonitor& RenderStreamMonitor();
@@ -12,6 +12,7 @@
 
 #include "Math/UnitConversion.h"
 #include "RenderStream.h"
+#include "RenderStreamMemory.h"
 #include "Kismet/GameplayStatics.h"
 
 #include "RenderStreamSettings.h"
@@ -41,9 +42,10 @@ static EUnit distanceUnit()
     return ret;
 }
 
-FRenderStreamProjectionPolicy::FRenderStreamProjectionPolicy(const FString& _ViewportId, const TMap<FString, FString>& _Parameters)
+FRenderStreamProjectionPolicy::FRenderStreamProjectionPolicy(const FString& _ViewportId, const TMap<FString, FString>& _Parameters, int32 _PolicyIndex)
     : ViewportId(_ViewportId)
     , Parameters(_Parameters)
+    , PolicyIndex(_PolicyIndex)
     , NCP(0)
     , FCP(0)
     , Module(nullptr)
@@ -77,28 +79,64 @@ void FRenderStreamProjectionPolicy::StartScene(UWorld* World)
         UE_LOG(LogRenderStreamPolicy, Error, TEXT("Policy '%s' created without corresponding viewport"), *GetViewportId());
         return;
     }
-    const FIntPoint Offset(Viewport->Region.X, Viewport->Region.Y);
-    const FIntPoint Resolution(Viewport->Region.W, Viewport->Region.H);
+    ViewportResolution = FIntPoint(Viewport->Region.W, Viewport->Region.H);
+
+    AssignStream(Module->GetAssignedStream(GetViewportId()));
+}
+
+bool FRenderStreamProjectionPolicy::AssignStream(const FString& StreamName)
+{
+    check(IsInGameThread());
+
+    // Rate state of the previous stream. Its last frame is not in the new stream's buffer, so the first frame renders.
+    FrameRateDivisor = 1;
+    RenderedFrame = false;
+    RenderedFrames = 0;
+    RateWindowStart = 0;
+    RealisedFrameRate = 0.f;
+
+    // Responses left from the previous stream were requested for its camera.
+    {
+        std::lock_guard<std::mutex> guard(m_frameResponsesLock);
+        m_frameResponses.clear();
+    }
+
+    if (StreamName.IsEmpty())
+    {
+        UE_LOG(LogRenderStreamPolicy, Log, TEXT("Policy '%s' has no stream assigned"), *GetViewportId());
+        Stream = nullptr;
+        return true;
+    }
 
     // Allocate the stream.
-    Stream = Module->StreamPool->GetStream(GetViewportId());
-    if (!Stream && Module->PopulateStreamPool())
+    TSharedPtr<FFrameStream> NewStream = Module->StreamPool->GetStream(StreamName);
+    if (!NewStream && Module->PopulateStreamPool())
     {
-        Stream = Module->StreamPool->GetStream(GetViewportId());
+        NewStream = Module->StreamPool->GetStream(StreamName);
     }
-    if (!Stream)
+    if (!NewStream)
     {
-        UE_LOG(LogRenderStreamPolicy, Error, TEXT("Policy '%s' created for unknown stream"), *GetViewportId());
-        return;
+        UE_LOG(LogRenderStreamPolicy, Error, TEXT("Policy '%s' created for unknown stream '%s'"), *GetViewportId(), *StreamName);
+        Stream = nullptr;
+        return false;
     }
-    if (Stream->Resolution() != Resolution)
+
+    BindStream(NewStream);
+
+    if (Stream->Resolution() != ViewportResolution)
     {
-        UE_LOG(LogRenderStreamPolicy, Error, TEXT("Policy '%s' created with incorrect resolution: %dx%d vs expected %dx%d"), *GetViewportId(), Resolution.X, Resolution.Y, Stream->Resolution().X, Stream->Resolution().Y);
-        return;
+        UE_LOG(LogRenderStreamPolicy, Error, TEXT("Policy '%s' created with incorrect resolution: %dx%d vs expected %dx%d"), *GetViewportId(), ViewportResolution.X, ViewportResolution.Y, Stream->Resolution().X, Stream->Resolution().Y);
+        return false;
     }
 
     const FString& Channel = Stream->Channel();
     const TWeakObjectPtr<ACameraActor> ChannelCamera = URenderStreamChannelDefinition::GetChannelCamera(Channel);
+    if (ChannelCamera.IsValid())
+    {
+        if (URenderStreamChannelDefinition* Definition = ChannelCamera->FindComponentByClass<URenderStreamChannelDefinition>())
+            FrameRateDivisor = FMath::Clamp(Definition->FrameRateDivisor, 1, URenderStreamChannelDefinition::MaxFrameRateDivisor);
+    }
+
     if (Template != ChannelCamera)
     {
         Template = ChannelCamera;
@@ -114,12 +152,20 @@ void FRenderStreamProjectionPolicy::StartScene(UWorld* World)
                 const FString TypeString = DefaultVisible ? "visible" : "hidden";
                 UE_LOG(LogRenderStreamPolicy, Log, TEXT("%d cameras registered to channel, filtering %d actors, default visibility '%s'"),
                     URenderStreamChannelDefinition::GetChannelCameraNum(Channel), Actors.Num(), *TypeString);
+                if (FrameRateDivisor > 1)
+                    UE_LOG(LogRenderStreamPolicy, Log, TEXT("Channel '%s' rendered at 1/%d of the frame rate"), *Channel, FrameRateDivisor);
             }
 
+            // A stream moved here by the cluster scheduler replaces the camera of the stream it took over from.
+            UWorld* World = Template->GetWorld();
+            if (Camera.IsValid() && Camera->GetWorld() == World)
+                Camera->Destroy();
+
             // Spawn the instance of the template camera needed for this policy / view.
+            RS_LLM_SCOPE(ERenderStreamMemory::Cameras);
             FActorSpawnParameters ActorSpawnParameters;
             ActorSpawnParameters.Template = Template.Get();
-            Camera = Template->GetWorld()->SpawnActor<class ACameraActor>(Template->GetClass(), ActorSpawnParameters);
+            Camera = World->SpawnActor<class ACameraActor>(Template->GetClass(), ActorSpawnParameters);
             if (URenderStreamChannelDefinition* ClonedDefinition = Camera->FindComponentByClass<URenderStreamChannelDefinition>())
                 ClonedDefinition->UnregisterCamera();
 
@@ -144,19 +190,35 @@ void FRenderStreamProjectionPolicy::StartScene(UWorld* World)
                 UE_LOG(LogRenderStream, Warning, TEXT("Could not set new view target for capturng."));
         }
         else
+        {
             UE_LOG(LogRenderStreamPolicy, Log, TEXT("Channel '%s' currently not mapped to a camera"), *Channel);
+
+            // The camera of the previous stream's channel would render the wrong viewpoint.
+            if (Camera.IsValid())
+            {
+                UE_LOG(LogRenderStreamPolicy, Warning, TEXT("Policy '%s' destroyed camera '%s', stream '%s' has no camera to replace it"), *GetViewportId(), *Camera->GetName(), *StreamName);
+                Camera->Destroy();
+            }
+            Camera = nullptr;
+        }
     }
+    return true;
 }
 
 void FRenderStreamProjectionPolicy::ApplyCameraData(const RenderStreamLink::FrameData& frameData, const RenderStreamLink::CameraData& cameraData)
 {
-    // Each call must always have a frame response, because there will be a corresponding render call.
+    // Not requested this frame, the view is skipped so there will be no corresponding render call.
+    if (cameraData.cameraHandle == 0)
+        return;
+
+    // Each requested camera must always have a frame response, because there will be a corresponding render call.
     {
+        RS_LLM_SCOPE(ERenderStreamMemory::Responses);
         std::lock_guard<std::mutex> guard(m_frameResponsesLock);
         m_frameResponses.push_back({ frameData.tTracked, cameraData });
     }
 
-    if (!Camera.IsValid() || cameraData.cameraHandle == 0)
+    if (!Camera.IsValid())
         return;
 
     // Attach the instanced Camera to the Capture object for this view.
@@ -194,6 +256,47 @@ void FRenderStreamProjectionPolicy::ApplyCameraData(const RenderStreamLink::Fram
     }
 }
 
+void FRenderStreamProjectionPolicy::BindStream(const TSharedPtr<FFrameStream>& InStream)
+{
+    Module = FRenderStreamModule::Get();
+    Stream = InStream;
+    FrameRateStatName = std::string(TCHAR_TO_UTF8(*Stream->Name())) + " Rate";
+    QueueDepthStatName = std::string(TCHAR_TO_UTF8(*Stream->Name())) + " Queue Depth";
+}
+
+void FRenderStreamProjectionPolicy::UpdateFrameRate(bool Rendered)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (RateWindowStart == 0)
+        RateWindowStart = Now;
+
+    if (Rendered)
+    {
+        RenderedFrame = true;
+        ++RenderedFrames;
+    }
+
+    const double Elapsed = Now - RateWindowStart;
+    if (Elapsed >= 1.0)
+    {
+        RealisedFrameRate = float(RenderedFrames / Elapsed);
+        RenderedFrames = 0;
+        RateWindowStart = Now;
+    }
+}
+
+int32 FRenderStreamProjectionPolicy::GetQueueDepth()
+{
+    std::lock_guard<std::mutex> guard(m_frameResponsesLock);
+    return int32(m_frameResponses.size());
+}
+
+uint64 FRenderStreamProjectionPolicy::GetQueueMemory()
+{
+    std::lock_guard<std::mutex> guard(m_frameResponsesLock);
+    return m_frameResponses.size() * sizeof(RenderStreamLink::CameraResponseData);
+}
+
 void FRenderStreamProjectionPolicy::EndScene()
 {
     check(IsInGameThread());
@@ -273,7 +376,12 @@ bool FRenderStreamProjectionPolicy::GetProjectionMatrix(const uint32 ViewIdx, FM
 
 void FRenderStreamProjectionPolicy::ApplyWarpBlend_RenderThread(const uint32 ViewIdx, FRHICommandListImmediate& RHICmdList, FRHITexture2D* SrcTexture, const FIntRect& ViewportRect)
 {
-    check(Stream);
+    if (!Stream || !Module->IsStreamRequested_RenderThread(PolicyIndex))
+    {
+        // d3 did not request this stream this frame, nothing was rendered for it.
+        return;
+    }
+
     RenderStreamLink::CameraResponseData frameResponse;
     {
         std::lock_guard<std::mutex> guard(m_frameResponsesLock);
@@ -286,7 +394,11 @@ void FRenderStreamProjectionPolicy::ApplyWarpBlend_RenderThread(const uint32 Vie
         frameResponse = m_frameResponses.front();
         m_frameResponses.pop_front();
     }
-    Stream->SendFrame_RenderingThread(RHICmdList, frameResponse, SrcTexture, ViewportRect);
+
+    if (Module->IsStreamRendered_RenderThread(PolicyIndex))
+        Stream->SendFrame_RenderingThread(RHICmdList, frameResponse, SrcTexture, ViewportRect);
+    else
+        Stream->ResendFrame_RenderingThread(RHICmdList, frameResponse); // skipped by the frame-rate divisor
 }
 
 const ACameraActor* FRenderStreamProjectionPolicy::GetTemplateCamera() const
@@ -337,7 +449,7 @@ TSharedPtr<IDisplayClusterProjectionPolicy> FRenderStreamProjectionPolicyFactory
 
     if (!PolicyType.Compare(FRenderStreamProjectionPolicyFactory::RenderStreamPolicyType, ESearchCase::IgnoreCase))
     {
-        TSharedPtr<FRenderStreamProjectionPolicy> Result = MakeShareable(new FRenderStreamProjectionPolicy(ViewportId, Parameters));
+        TSharedPtr<FRenderStreamProjectionPolicy> Result = MakeShareable(new FRenderStreamProjectionPolicy(ViewportId, Parameters, Policies.Num()));
         Policies.Add(Result);
         return StaticCastSharedPtr<IDisplayClusterProjectionPolicy>(Result);
     }
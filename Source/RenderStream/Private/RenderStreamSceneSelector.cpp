@@ -1,9 +1,16 @@
 #include "RenderStreamSceneSelector.h"
 #include "Core.h"
 #include "GameFramework/Actor.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeExit.h"
 #include <string.h>
 #include <malloc.h>
 #include "RenderStream.h"
+#include "RenderStreamDmx.h"
+#include "RenderStreamMemory.h"
+#include "RenderStreamSchemaBuilder.h"
+#include "RenderStreamSchemaIndex.h"
+#include "RenderStreamStats.h"
 
 RenderStreamSceneSelector::~RenderStreamSceneSelector() = default;
 
@@ -16,8 +23,35 @@ const RenderStreamLink::Schema& RenderStreamSceneSelector::Schema() const
 }
 
 
-void RenderStreamSceneSelector::LoadSchemas(const UWorld& World)
+// Warn about scenes whose own parameters no longer match the project's schema index, the schema d3 has is stale.
+static void CheckAgainstSchemaIndex(const RenderStreamLink::Schema& Schema, const FRenderStreamSchemaIndex& Index)
 {
+    // Scenes are named after their level, whose own parameters come last.
+    TMap<FString, uint32> LevelsByName;
+    for (uint32 i = 0; i < Index.NumLevels(); ++i)
+        LevelsByName.Add(FPackageName::GetShortName(UTF8_TO_TCHAR(Index.String(Index.Level(i).Path))), i);
+
+    for (size_t i = 0; i < Schema.scenes.nScenes; ++i)
+    {
+        const RenderStreamLink::RemoteParameters& Scene = Schema.scenes.scenes[i];
+        const uint32* LevelIndex = LevelsByName.Find(UTF8_TO_TCHAR(Scene.name));
+        if (!LevelIndex)
+            continue;
+
+        const FRenderStreamSchemaIndex::FLevel& Level = Index.Level(*LevelIndex);
+        bool Matches = Level.NumParameters <= Scene.nParameters;
+        const size_t Offset = Scene.nParameters - Level.NumParameters;
+        for (uint32 j = 0; Matches && j < Level.NumParameters; ++j)
+            Matches = FCStringAnsi::Strcmp(Index.String(Index.Parameter(Level, j).Key), Scene.parameters[Offset + j].key) == 0;
+
+        if (!Matches)
+            UE_LOG(LogRenderStream, Warning, TEXT("Schema for scene %s is out of date with the project, save a level in the editor to regenerate it"), UTF8_TO_TCHAR(Scene.name));
+    }
+}
+
+void RenderStreamSceneSelector::LoadSchemas(const UWorld& World, const FRenderStreamSchemaIndex* Index)
+{
+    RS_LLM_SCOPE(ERenderStreamMemory::Schema);
     const std::string AssetPath = TCHAR_TO_UTF8(*FPaths::GetProjectFilePath());
     uint32_t nBytes = 0;
     RenderStreamLink::instance().rs_loadSchema(AssetPath.c_str(), nullptr, &nBytes);
@@ -40,6 +74,8 @@ void RenderStreamSceneSelector::LoadSchemas(const UWorld& World)
     bool loaded = true;
     if (res == RenderStreamLink::RS_ERROR_SUCCESS)
     {
+        if (Index)
+            CheckAgainstSchemaIndex(Schema(), *Index);
         if (!OnLoadedSchema(World, Schema()))
         {
             UE_LOG(LogRenderStream, Error, TEXT("Incomptible schema"));
@@ -56,14 +92,10 @@ void RenderStreamSceneSelector::LoadSchemas(const UWorld& World)
     if (!loaded)
     {
         m_schemaMem.clear();
-        m_defaultSchema.reset();
-        RenderStreamLink::Schema& Schema = m_defaultSchema.schema;
-        Schema.scenes.nScenes = 1;
-        Schema.scenes.scenes = static_cast<RenderStreamLink::RemoteParameters*>(malloc(Schema.scenes.nScenes * sizeof(RenderStreamLink::RemoteParameters)));
-        Schema.scenes.scenes[0].name = _strdup("Default");
-        Schema.scenes.scenes[0].nParameters = 0;
-        Schema.scenes.scenes[0].parameters = nullptr;
-        res = RenderStreamLink::instance().rs_setSchema(&Schema);
+        FRenderStreamSchemaBuilder Builder;
+        Builder.AddScene("Default");
+        m_defaultSchema = Builder.Build();
+        res = RenderStreamLink::instance().rs_setSchema(&m_defaultSchema.schema);
         if (res != RenderStreamLink::RS_ERROR_SUCCESS)
             UE_LOG(LogRenderStream, Error, TEXT("Unable to set default schema - error %d"), res);
     }
@@ -236,8 +268,27 @@ size_t RenderStreamSceneSelector::ValidateParameters(const AActor* Root, RenderS
     return nParameters;
 }
 
+double RenderStreamSceneSelector::TakeParameterApplyTime()
+{
+    const double Time = m_parameterApplyTime;
+    m_parameterApplyTime = 0;
+    return Time;
+}
+
+const char* RenderStreamSceneSelector::SceneName(uint32_t sceneId) const
+{
+    return sceneId < Schema().scenes.nScenes ? Schema().scenes.scenes[sceneId].name : nullptr;
+}
+
 void RenderStreamSceneSelector::ApplyParameters(size_t sceneId, std::initializer_list<AActor*> Actors) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_ApplyParameters);
+    const double StartTime = FPlatformTime::Seconds();
+    ON_SCOPE_EXIT
+    {
+        m_parameterApplyTime += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    };
+
     check(sceneId < Schema().scenes.nScenes);
     const RenderStreamLink::RemoteParameters& params = Schema().scenes.scenes[sceneId];
 
@@ -251,6 +302,9 @@ void RenderStreamSceneSelector::ApplyParameters(size_t sceneId, std::initializer
         UE_LOG(LogRenderStream, Error, TEXT("Unable to get float frame parameters - %d"), res);
         return;
     }
+    ++m_parameterUpdates;
+
+    RenderStreamDmxReceiver().Merge(params, floatValues.data(), floatValues.size());
 
     size_t offset = 0;
 
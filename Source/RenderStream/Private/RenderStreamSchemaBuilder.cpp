@@ -0,0 +1,108 @@
+#include "RenderStreamSchemaBuilder.h"
+
+#include <stdlib.h>
+
+void FRenderStreamSchemaBuilder::AddChannel(const char* Channel)
+{
+    m_channels.push_back(Intern(Channel));
+}
+
+void FRenderStreamSchemaBuilder::AddScene(const char* Name)
+{
+    m_scenes.push_back({ Intern(Name), uint32(m_parameters.size()), 0 });
+}
+
+void FRenderStreamSchemaBuilder::AddParameter(const char* Group, const char* DisplayName, const char* Key, float Min, float Max, float Step, float DefaultValue, int32 DmxOffset, uint32 DmxType)
+{
+    check(!m_scenes.empty());
+    m_parameters.push_back({ Intern(Group), Intern(DisplayName), Intern(Key), Min, Max, Step, DefaultValue, uint32(m_options.size()), 0, DmxOffset, DmxType });
+    ++m_scenes.back().NumParameters;
+}
+
+void FRenderStreamSchemaBuilder::AddOption(const char* Option)
+{
+    check(!m_parameters.empty());
+    m_options.push_back(Intern(Option));
+    ++m_parameters.back().NumOptions;
+}
+
+uint32 FRenderStreamSchemaBuilder::Intern(const char* String)
+{
+    const auto It = m_interned.find(String);
+    if (It != m_interned.end())
+        return It->second;
+
+    const uint32 Offset = uint32(m_strings.size());
+    m_strings.append(String);
+    m_strings.push_back('\0');
+    m_interned.emplace(String, Offset);
+    return Offset;
+}
+
+RenderStreamLink::ScopedSchema FRenderStreamSchemaBuilder::Build() const
+{
+    // Sections in arena order, each aligned for the pointers it holds.
+    auto AlignPointers = [](size_t Offset) { return Align(Offset, sizeof(void*)); };
+    const size_t ChannelsOffset = 0;
+    const size_t ScenesOffset = AlignPointers(ChannelsOffset + m_channels.size() * sizeof(const char*));
+    const size_t ParametersOffset = AlignPointers(ScenesOffset + m_scenes.size() * sizeof(RenderStreamLink::RemoteParameters));
+    const size_t OptionsOffset = AlignPointers(ParametersOffset + m_parameters.size() * sizeof(RenderStreamLink::RemoteParameter));
+    const size_t StringsOffset = OptionsOffset + m_options.size() * sizeof(const char*);
+    const size_t Size = StringsOffset + m_strings.size();
+
+    RenderStreamLink::ScopedSchema Scoped;
+    if (Size == 0)
+        return Scoped;
+
+    uint8* Arena = static_cast<uint8*>(malloc(Size));
+    check(Arena);
+    Scoped.arena = Arena;
+    Scoped.arenaSize = Size;
+
+    char* Strings = reinterpret_cast<char*>(Arena + StringsOffset);
+    memcpy(Strings, m_strings.data(), m_strings.size());
+
+    const char** Channels = reinterpret_cast<const char**>(Arena + ChannelsOffset);
+    for (size_t i = 0; i < m_channels.size(); ++i)
+        Channels[i] = Strings + m_channels[i];
+
+    const char** Options = reinterpret_cast<const char**>(Arena + OptionsOffset);
+    for (size_t i = 0; i < m_options.size(); ++i)
+        Options[i] = Strings + m_options[i];
+
+    RenderStreamLink::RemoteParameter* Parameters = reinterpret_cast<RenderStreamLink::RemoteParameter*>(Arena + ParametersOffset);
+    for (size_t i = 0; i < m_parameters.size(); ++i)
+    {
+        const FParameter& In = m_parameters[i];
+        RenderStreamLink::RemoteParameter& Out = Parameters[i];
+        Out.group = Strings + In.Group;
+        Out.displayName = Strings + In.DisplayName;
+        Out.key = Strings + In.Key;
+        Out.min = In.Min;
+        Out.max = In.Max;
+        Out.step = In.Step;
+        Out.defaultValue = In.DefaultValue;
+        Out.nOptions = In.NumOptions;
+        Out.options = In.NumOptions ? Options + In.FirstOption : nullptr;
+        Out.dmxOffset = In.DmxOffset;
+        Out.dmxType = In.DmxType;
+    }
+
+    RenderStreamLink::RemoteParameters* Scenes = reinterpret_cast<RenderStreamLink::RemoteParameters*>(Arena + ScenesOffset);
+    for (size_t i = 0; i < m_scenes.size(); ++i)
+    {
+        const FScene& In = m_scenes[i];
+        RenderStreamLink::RemoteParameters& Out = Scenes[i];
+        Out.name = Strings + In.Name;
+        Out.nParameters = In.NumParameters;
+        Out.parameters = In.NumParameters ? Parameters + In.FirstParameter : nullptr;
+        Out.hash = 0; // filled in by rs_setSchema
+    }
+
+    RenderStreamLink::Schema& Schema = Scoped.schema;
+    Schema.channels.nChannels = uint32_t(m_channels.size());
+    Schema.channels.channels = m_channels.empty() ? nullptr : Channels;
+    Schema.scenes.nScenes = uint32_t(m_scenes.size());
+    Schema.scenes.scenes = m_scenes.empty() ? nullptr : Scenes;
+    return Scoped;
+}
@@ -0,0 +1,263 @@
+#include "RenderStreamSchemaIndex.h"
+
+#include "RenderStream.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace RenderStreamSchemaIndex;
+
+FString FRenderStreamSchemaIndex::DefaultPath()
+{
+    return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("RenderStream"), TEXT("SchemaIndex.rsidx"));
+}
+
+TUniquePtr<FRenderStreamSchemaIndex> FRenderStreamSchemaIndex::Open(const FString& Path)
+{
+    TUniquePtr<FRenderStreamSchemaIndex> Index(new FRenderStreamSchemaIndex());
+    Index->m_file.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+    if (!Index->m_file || Index->m_file->GetFileSize() < int64(sizeof(FHeader)))
+        return nullptr;
+
+    Index->m_region.Reset(Index->m_file->MapRegion(0, Index->m_file->GetFileSize()));
+    if (!Index->m_region)
+        return nullptr;
+
+    Index->m_data = Index->m_region->GetMappedPtr();
+    Index->m_size = Index->m_region->GetMappedSize();
+    if (!Index->Validate())
+    {
+        UE_LOG(LogRenderStream, Warning, TEXT("Ignoring invalid or out of date schema index %s"), *Path);
+        return nullptr;
+    }
+    return Index;
+}
+
+FRenderStreamSchemaIndex::~FRenderStreamSchemaIndex() = default;
+
+bool FRenderStreamSchemaIndex::Validate() const
+{
+    // Checked once here, so every accessor can index the mapping directly.
+    const FHeader& H = Header();
+    if (H.Magic != Magic || H.Version != Version || H.FileSize != m_size)
+        return false;
+
+    auto SectionFits = [this](uint32 Offset, uint64 Num, uint64 Size)
+    {
+        return Offset % 4 == 0 && uint64(Offset) + Num * Size <= uint64(m_size);
+    };
+    if (!SectionFits(H.LevelsOffset, H.NumLevels, sizeof(FLevel)) ||
+        !SectionFits(H.ParametersOffset, H.NumParameters, sizeof(FParameter)) ||
+        !SectionFits(H.IndicesOffset, H.NumIndices, sizeof(uint32)) ||
+        !SectionFits(H.StringsOffset, H.StringsSize, 1))
+        return false;
+    if (H.StringsSize > 0 && m_data[H.StringsOffset + H.StringsSize - 1] != 0)
+        return false;
+
+    auto StringFits = [&H](uint32 Offset) { return Offset < H.StringsSize; };
+    auto RangeFits = [&H](const FStringRange& Range) { return uint64(Range.First) + Range.Num <= H.NumIndices; };
+
+    const uint32* Indices = Section<uint32>(H.IndicesOffset);
+    for (uint32 i = 0; i < H.NumIndices; ++i)
+    {
+        if (!StringFits(Indices[i]))
+            return false;
+    }
+
+    const FLevel* Levels = Section<FLevel>(H.LevelsOffset);
+    for (uint32 i = 0; i < H.NumLevels; ++i)
+    {
+        const FLevel& L = Levels[i];
+        if (!StringFits(L.Path) || !StringFits(L.SourceHash) || !RangeFits(L.SubLevels) || !RangeFits(L.Channels) ||
+            uint64(L.FirstParameter) + L.NumParameters > H.NumParameters)
+            return false;
+    }
+
+    const FParameter* Parameters = Section<FParameter>(H.ParametersOffset);
+    for (uint32 i = 0; i < H.NumParameters; ++i)
+    {
+        const FParameter& P = Parameters[i];
+        if (!StringFits(P.Group) || !StringFits(P.DisplayName) || !StringFits(P.Key) || !RangeFits(P.Options))
+            return false;
+    }
+    return true;
+}
+
+int32 FRenderStreamSchemaIndex::FindLevel(const FString& Path) const
+{
+    const FTCHARToUTF8 Key(*Path);
+    int32 Min = 0;
+    int32 Max = int32(NumLevels());
+    while (Min < Max)
+    {
+        const int32 Mid = Min + (Max - Min) / 2;
+        const int Order = FCStringAnsi::Strcmp(String(Level(Mid).Path), Key.Get());
+        if (Order == 0)
+            return Mid;
+        if (Order < 0)
+            Min = Mid + 1;
+        else
+            Max = Mid;
+    }
+    return INDEX_NONE;
+}
+
+FRenderStreamSchemaIndexWriter::FRenderStreamSchemaIndexWriter(const FRenderStreamSchemaIndex* Existing)
+{
+    if (!Existing)
+        return;
+
+    for (uint32 i = 0; i < Existing->NumLevels(); ++i)
+    {
+        const FLevel& Level = Existing->Level(i);
+        FEntry& Entry = m_levels.Add(UTF8_TO_TCHAR(Existing->String(Level.Path)));
+        Entry.SourceHash = UTF8_TO_TCHAR(Existing->String(Level.SourceHash));
+        for (uint32 j = 0; j < Level.SubLevels.Num; ++j)
+            Entry.Metadata.SubLevels.Add(FSoftObjectPath(UTF8_TO_TCHAR(Existing->String(Level.SubLevels, j))));
+        for (uint32 j = 0; j < Level.Channels.Num; ++j)
+            Entry.Metadata.Channels.Add(UTF8_TO_TCHAR(Existing->String(Level.Channels, j)));
+        for (uint32 j = 0; j < Level.NumParameters; ++j)
+        {
+            const FParameter& Parameter = Existing->Parameter(Level, j);
+            FRenderStreamExposedParameterEntry& Out = Entry.Metadata.ExposedParams.Emplace_GetRef();
+            Out.Group = UTF8_TO_TCHAR(Existing->String(Parameter.Group));
+            Out.DisplayName = UTF8_TO_TCHAR(Existing->String(Parameter.DisplayName));
+            Out.Key = UTF8_TO_TCHAR(Existing->String(Parameter.Key));
+            Out.Min = Parameter.Min;
+            Out.Max = Parameter.Max;
+            Out.Step = Parameter.Step;
+            Out.DefaultValue = Parameter.DefaultValue;
+            for (uint32 k = 0; k < Parameter.Options.Num; ++k)
+                Out.Options.Add(UTF8_TO_TCHAR(Existing->String(Parameter.Options, k)));
+            Out.DmxOffset = Parameter.DmxOffset;
+            Out.DmxType = Parameter.DmxType;
+        }
+    }
+}
+
+void FRenderStreamSchemaIndexWriter::SetLevel(const FString& Path, const FRenderStreamLevelMetadata& Metadata, const FString& SourceHash)
+{
+    m_levels.Add(Path, { Metadata, SourceHash });
+}
+
+void FRenderStreamSchemaIndexWriter::RemoveLevel(const FString& Path)
+{
+    m_levels.Remove(Path);
+}
+
+TArray<FString> FRenderStreamSchemaIndexWriter::LevelPaths() const
+{
+    TArray<FString> Paths;
+    m_levels.GenerateKeyArray(Paths);
+    return Paths;
+}
+
+bool FRenderStreamSchemaIndexWriter::Save(const FString& Path) const
+{
+    std::string Strings;
+    std::unordered_map<std::string, uint32> Interned;
+    auto AddString = [&](const FString& String) -> uint32
+    {
+        std::string Utf8 = TCHAR_TO_UTF8(*String);
+        const auto It = Interned.find(Utf8);
+        if (It != Interned.end())
+            return It->second;
+
+        const uint32 Offset = uint32(Strings.size());
+        Strings.append(Utf8);
+        Strings.push_back('\0');
+        Interned.emplace(std::move(Utf8), Offset);
+        return Offset;
+    };
+
+    std::vector<uint32> Indices;
+    auto AddStrings = [&](auto&& Range) -> FStringRange
+    {
+        FStringRange Out = { uint32(Indices.size()), 0 };
+        for (const auto& String : Range)
+        {
+            Indices.push_back(AddString(String));
+            ++Out.Num;
+        }
+        return Out;
+    };
+
+    // FindLevel searches in byte order, which the sorted map's case insensitive order isn't.
+    std::vector<std::pair<std::string, const TPair<FString, FEntry>*>> Sorted;
+    for (const auto& Level : m_levels)
+        Sorted.emplace_back(TCHAR_TO_UTF8(*Level.Key), &Level);
+    std::sort(Sorted.begin(), Sorted.end(), [](const auto& A, const auto& B) { return A.first < B.first; });
+
+    std::vector<FLevel> Levels;
+    std::vector<FParameter> Parameters;
+    for (const auto& Level : Sorted)
+    {
+        const FString& LevelPath = Level.second->Key;
+        const FEntry& Entry = Level.second->Value;
+
+        TArray<FString> SubLevels;
+        for (const FSoftObjectPath& SubLevel : Entry.Metadata.SubLevels)
+            SubLevels.Add(SubLevel.ToString());
+
+        FLevel& Out = *Levels.emplace(Levels.end());
+        Out.Path = AddString(LevelPath);
+        Out.SourceHash = AddString(Entry.SourceHash);
+        Out.SubLevels = AddStrings(SubLevels);
+        Out.Channels = AddStrings(Entry.Metadata.Channels);
+        Out.FirstParameter = uint32(Parameters.size());
+        Out.NumParameters = uint32(Entry.Metadata.ExposedParams.Num());
+
+        for (const FRenderStreamExposedParameterEntry& Parameter : Entry.Metadata.ExposedParams)
+        {
+            FParameter& OutParameter = *Parameters.emplace(Parameters.end());
+            OutParameter.Group = AddString(Parameter.Group);
+            OutParameter.DisplayName = AddString(Parameter.DisplayName);
+            OutParameter.Key = AddString(Parameter.Key);
+            OutParameter.Min = Parameter.Min;
+            OutParameter.Max = Parameter.Max;
+            OutParameter.Step = Parameter.Step;
+            OutParameter.DefaultValue = Parameter.DefaultValue;
+            OutParameter.Options = AddStrings(Parameter.Options);
+            OutParameter.DmxOffset = Parameter.DmxOffset;
+            OutParameter.DmxType = Parameter.DmxType;
+        }
+    }
+
+    FHeader Header = {};
+    Header.Magic = Magic;
+    Header.Version = Version;
+    Header.NumLevels = uint32(Levels.size());
+    Header.LevelsOffset = sizeof(FHeader);
+    Header.NumParameters = uint32(Parameters.size());
+    Header.ParametersOffset = Header.LevelsOffset + Header.NumLevels * sizeof(FLevel);
+    Header.NumIndices = uint32(Indices.size());
+    Header.IndicesOffset = Header.ParametersOffset + Header.NumParameters * sizeof(FParameter);
+    Header.StringsSize = uint32(Strings.size());
+    Header.StringsOffset = Header.IndicesOffset + Header.NumIndices * sizeof(uint32);
+    Header.FileSize = Header.StringsOffset + Header.StringsSize;
+
+    TArray<uint8> Data;
+    Data.Reserve(Header.FileSize);
+    Data.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+    Data.Append(reinterpret_cast<const uint8*>(Levels.data()), Levels.size() * sizeof(FLevel));
+    Data.Append(reinterpret_cast<const uint8*>(Parameters.data()), Parameters.size() * sizeof(FParameter));
+    Data.Append(reinterpret_cast<const uint8*>(Indices.data()), Indices.size() * sizeof(uint32));
+    Data.Append(reinterpret_cast<const uint8*>(Strings.data()), Strings.size());
+    check(Data.Num() == Header.FileSize);
+
+    const FString TempPath = Path + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Data, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Failed to write schema index %s"), *Path);
+        return false;
+    }
+    return true;
+}
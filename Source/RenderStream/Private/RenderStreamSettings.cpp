@@ -5,5 +5,18 @@
 URenderStreamSettings::URenderStreamSettings(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
     , SceneSelector(ERenderStreamSceneSelector::None)
+    , ResidentSceneMemoryBudget(0)
+    , LogForwardingVerbosity(ERenderStreamLogVerbosity::Log)
+    , LogForwardingRateLimit(200)
+    , SyncStallThreshold(2.f)
+    , SendStallThreshold(0.5f)
+    , GameThreadStallThreshold(10.f)
+    , bRecreateStalledStreams(false)
+    , bBalanceStreams(false)
+    , StreamBalanceInterval(10.f)
+    , StreamBalanceThreshold(0.1f)
+    , DmxPort(0)
+    , DmxFirstUniverse(0)
+    , DmxUniverses(1)
 {}
 
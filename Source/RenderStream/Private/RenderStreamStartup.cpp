@@ -0,0 +1,50 @@
+#include "RenderStreamStartup.h"
+
+#include "RenderStream.h"
+
+#include "HAL/ThreadManager.h"
+#include "Misc/ScopeLock.h"
+
+void FRenderStreamStartupTimeline::Add(const TCHAR* Stage, double StartTime, double EndTime)
+{
+    FString Thread = IsInGameThread() ? TEXT("GameThread") : FThreadManager::GetThreadName(FPlatformTLS::GetCurrentThreadId());
+    if (Thread.IsEmpty())
+        Thread = FString::Printf(TEXT("Thread %u"), FPlatformTLS::GetCurrentThreadId());
+
+    FScopeLock Lock(&m_lock);
+    m_stages.Add({ Stage, StartTime, EndTime, MoveTemp(Thread) });
+}
+
+void FRenderStreamStartupTimeline::Log()
+{
+    FScopeLock Lock(&m_lock);
+    if (m_logged)
+        return;
+    m_logged = true;
+
+    m_stages.StableSort([](const FStage& A, const FStage& B) { return A.StartTime < B.StartTime; });
+    UE_LOG(LogRenderStream, Display, TEXT("Startup timeline, ms since process start:"));
+    for (const FStage& Stage : m_stages)
+    {
+        UE_LOG(LogRenderStream, Display, TEXT("  %9.1f %+9.1f  %-24s %s"), (Stage.StartTime - GStartTime) * 1000.0,
+            (Stage.EndTime - Stage.StartTime) * 1000.0, Stage.Name, *Stage.Thread);
+    }
+    m_stages.Empty();
+}
+
+FRenderStreamStartupTimeline::FScope::FScope(const TCHAR* InStage)
+    : Stage(InStage)
+    , StartTime(FPlatformTime::Seconds())
+{
+}
+
+FRenderStreamStartupTimeline::FScope::~FScope()
+{
+    RenderStreamStartup().Add(Stage, StartTime, FPlatformTime::Seconds());
+}
+
+FRenderStreamStartupTimeline& RenderStreamStartup()
+{
+    static FRenderStreamStartupTimeline Timeline;
+    return Timeline;
+}
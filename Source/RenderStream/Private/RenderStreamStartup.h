@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Records how long each stage of bringing a node up took and on which thread, from module load to the first scene,
+// and logs them as one timeline. Times are relative to process start, so gaps show where the engine itself spent time.
+class FRenderStreamStartupTimeline
+{
+public:
+    // Thread safe, stages can be recorded from the background work startup runs concurrently.
+    void Add(const TCHAR* Stage, double StartTime, double EndTime);
+    // Logs the timeline the first time it is called.
+    void Log();
+
+    // Records the enclosing scope as a stage.
+    struct FScope
+    {
+        explicit FScope(const TCHAR* InStage);
+        ~FScope();
+
+        const TCHAR* Stage;
+        double StartTime;
+    };
+
+private:
+    struct FStage
+    {
+        const TCHAR* Name;
+        double StartTime;
+        double EndTime;
+        FString Thread;
+    };
+
+    FCriticalSection m_lock;
+    TArray<FStage> m_stages;
+    bool m_logged = false;
+};
+
+FRenderStreamStartupTimeline& RenderStreamStartup();
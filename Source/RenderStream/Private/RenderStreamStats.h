@@ -7,3 +7,9 @@ DECLARE_STATS_GROUP(TEXT("RenderStream"), STATGROUP_RenderStream, STATCAT_Advanc
 
 DECLARE_CYCLE_STAT(TEXT("Await Frame (Controller)"), STAT_AwaitFrame, STATGROUP_RenderStream);
 DECLARE_CYCLE_STAT(TEXT("Receive Frame (Follower)"), STAT_ReceiveFrame, STATGROUP_RenderStream);
+DECLARE_CYCLE_STAT(TEXT("Apply Scene"), STAT_ApplyScene, STATGROUP_RenderStream);
+DECLARE_CYCLE_STAT(TEXT("Apply Parameters"), STAT_ApplyParameters, STATGROUP_RenderStream);
+DECLARE_CYCLE_STAT(TEXT("Apply Cameras"), STAT_ApplyCameras, STATGROUP_RenderStream);
+DECLARE_CYCLE_STAT(TEXT("Send Frame"), STAT_SendFrame, STATGROUP_RenderStream);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skipped Views"), STAT_SkippedViews, STATGROUP_RenderStream);
@@ -0,0 +1,134 @@
+#include "RenderStreamTelemetry.h"
+
+#include "RenderStream.h"
+
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+
+// Reads racing a write are retried, a writer at frame rate overtakes a copy this often only when the reader is starved.
+static constexpr int32 MaxReadAttempts = 16;
+
+FRenderStreamTelemetry::~FRenderStreamTelemetry()
+{
+    Close();
+}
+
+FString FRenderStreamTelemetry::DefaultName()
+{
+    FString Instance;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("dc_node="), Instance))
+        Instance = FString::FromInt(FPlatformProcess::GetCurrentProcessId());
+
+    FString Name = PageName(Instance);
+    FParse::Value(FCommandLine::Get(), TEXT("RenderStreamTelemetry="), Name);
+    return Name;
+}
+
+FString FRenderStreamTelemetry::PageName(const FString& Instance)
+{
+    return TEXT("RenderStreamTelemetry_") + Instance;
+}
+
+bool FRenderStreamTelemetry::Open(const FString& Name)
+{
+    Close();
+
+    m_region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, true,
+        uint32(FPlatformMemory::ESharedMemoryAccess::Read) | uint32(FPlatformMemory::ESharedMemoryAccess::Write), sizeof(FRenderStreamTelemetryPage));
+    if (!m_region)
+    {
+        UE_LOG(LogRenderStream, Warning, TEXT("Unable to create the telemetry page '%s'"), *Name);
+        return false;
+    }
+
+    m_page = static_cast<FRenderStreamTelemetryPage*>(m_region->GetAddress());
+    FMemory::Memzero(&m_page->Data, sizeof(m_page->Data));
+    m_page->Sequence.store(0, std::memory_order_relaxed);
+    m_page->Size = sizeof(FRenderStreamTelemetryPage);
+    m_page->Version = FRenderStreamTelemetryPage::PageVersion;
+    // Readers check the magic last, so they never see a page with a header from a different version.
+    std::atomic_thread_fence(std::memory_order_release);
+    m_page->Magic = FRenderStreamTelemetryPage::PageMagic;
+    UE_LOG(LogRenderStream, Log, TEXT("Publishing telemetry to '%s'"), *Name);
+    return true;
+}
+
+void FRenderStreamTelemetry::Close()
+{
+    if (!m_region)
+        return;
+
+    FPlatformMemory::UnmapNamedSharedMemoryRegion(m_region);
+    m_region = nullptr;
+    m_page = nullptr;
+}
+
+FRenderStreamTelemetryPage::FData& FRenderStreamTelemetry::BeginWrite()
+{
+    check(m_page);
+    m_page->Sequence.store(m_page->Sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    // The odd sequence has to be visible before any of the data changes.
+    std::atomic_thread_fence(std::memory_order_release);
+    return m_page->Data;
+}
+
+void FRenderStreamTelemetry::EndWrite()
+{
+    check(m_page);
+    m_page->Sequence.store(m_page->Sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+FRenderStreamTelemetry::FReader::~FReader()
+{
+    if (m_region)
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(m_region);
+}
+
+bool FRenderStreamTelemetry::FReader::Open(const FString& Name)
+{
+    if (m_region)
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(m_region);
+    m_page = nullptr;
+
+    m_region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, false, uint32(FPlatformMemory::ESharedMemoryAccess::Read), sizeof(FRenderStreamTelemetryPage));
+    if (!m_region)
+        return false;
+
+    const FRenderStreamTelemetryPage* Page = static_cast<const FRenderStreamTelemetryPage*>(m_region->GetAddress());
+    const bool bValid = Page->Magic == FRenderStreamTelemetryPage::PageMagic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!bValid || Page->Version != FRenderStreamTelemetryPage::PageVersion || Page->Size != sizeof(FRenderStreamTelemetryPage))
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Telemetry page '%s' is not version %u of this layout"), *Name, FRenderStreamTelemetryPage::PageVersion);
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(m_region);
+        m_region = nullptr;
+        return false;
+    }
+
+    m_page = Page;
+    return true;
+}
+
+bool FRenderStreamTelemetry::FReader::Read(FRenderStreamTelemetryPage::FData& Out) const
+{
+    if (!m_page)
+        return false;
+
+    for (int32 Attempt = 0; Attempt < MaxReadAttempts; ++Attempt)
+    {
+        const uint32 Before = m_page->Sequence.load(std::memory_order_acquire);
+        if (Before == 0)
+            return false; // nothing published yet
+        if (Before & 1)
+        {
+            FPlatformProcess::Yield();
+            continue;
+        }
+
+        FMemory::Memcpy(&Out, &m_page->Data, sizeof(Out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_page->Sequence.load(std::memory_order_relaxed) == Before)
+            return true;
+    }
+    return false;
+}
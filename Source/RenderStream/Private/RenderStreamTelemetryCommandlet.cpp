@@ -0,0 +1,72 @@
+#include "RenderStreamTelemetryCommandlet.h"
+
+#include "RenderStreamTelemetry.h"
+
+#include "HAL/PlatformProcess.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogRenderStreamTelemetry, Log, All);
+
+URenderStreamTelemetryCommandlet::URenderStreamTelemetryCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 URenderStreamTelemetryCommandlet::Main(const FString& Params)
+{
+    FString Name;
+    FString Node;
+    if (FParse::Value(*Params, TEXT("Node="), Node))
+        Name = FRenderStreamTelemetry::PageName(Node);
+    FParse::Value(*Params, TEXT("Name="), Name);
+    if (Name.IsEmpty())
+    {
+        UE_LOG(LogRenderStreamTelemetry, Error, TEXT("Pass the node to read with -Node=<nDisplay node id or process id> or -Name=<page name>"));
+        return 1;
+    }
+
+    int32 Interval = 500;
+    FParse::Value(*Params, TEXT("Interval="), Interval);
+    int32 Count = 0;
+    FParse::Value(*Params, TEXT("Count="), Count);
+
+    FRenderStreamTelemetry::FReader Reader;
+    if (!Reader.Open(Name))
+    {
+        UE_LOG(LogRenderStreamTelemetry, Error, TEXT("No telemetry page '%s', is the node running?"), *Name);
+        return 1;
+    }
+
+    uint64 LastFrame = 0;
+    FRenderStreamTelemetryPage::FData Data;
+    for (int32 i = 0; (Count <= 0 || i < Count) && !IsEngineExitRequested(); ++i)
+    {
+        if (i > 0)
+            FPlatformProcess::Sleep(Interval / 1000.f);
+
+        if (!Reader.Read(Data))
+        {
+            UE_LOG(LogRenderStreamTelemetry, Display, TEXT("No frame published"));
+            continue;
+        }
+
+        UE_LOG(LogRenderStreamTelemetry, Display, TEXT("Frame %llu%s, scene %u '%s', frame %.2f ms, await %.2f ms, receive %.2f ms, parameters %.1f/s in %.2f ms"),
+            Data.FrameNumber, Data.FrameNumber == LastFrame ? TEXT(" (stalled)") : TEXT(""), Data.Scene, UTF8_TO_TCHAR(Data.SceneName),
+            Data.FrameTime, Data.AwaitTime, Data.ReceiveTime, Data.ParameterUpdateRate, Data.ParameterApplyTime);
+        if (Data.Status[0])
+            UE_LOG(LogRenderStreamTelemetry, Display, TEXT("  Status: %s"), UTF8_TO_TCHAR(Data.Status));
+        for (uint32 s = 0; s < FMath::Min<uint32>(Data.NumStreams, FRenderStreamTelemetryPage::MaxStreams); ++s)
+        {
+            const FRenderStreamTelemetryPage::FStream& Stream = Data.Streams[s];
+            if (!Stream.Name[0])
+                continue;
+            UE_LOG(LogRenderStreamTelemetry, Display, TEXT("  %-24s sent %llu, dropped %llu, %.1f fps, queue %u, latency %.2f ms, copy %.2f ms, send %.2f ms, GPU copy %.2f ms"),
+                UTF8_TO_TCHAR(Stream.Name), Stream.FramesSent, Stream.FramesDropped, Stream.FrameRate, Stream.QueueDepth,
+                Stream.LatencyMs, Stream.CopyTime, Stream.SendTime, Stream.CopyGPUTime);
+        }
+        LastFrame = Data.FrameNumber;
+    }
+    return 0;
+}
@@ -0,0 +1,278 @@
+#include "RenderStreamTrace.h"
+
+#include "RenderStream.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+// File layout: FTraceHeader, NumStreamNames FStrings, NumFrames raw FRenderStreamTraceFrame records oldest first.
+// Records are written in native layout, RecordSize guards against reading a file from a different build.
+static constexpr uint32 TraceMagic = 0x52545352; // "RSTR"
+static constexpr uint32 TraceVersion = 1;
+static constexpr float RecordTimeBudget = 0.1f; // ms
+
+namespace {
+    struct FTraceHeader
+    {
+        uint32 Magic = TraceMagic;
+        uint32 Version = TraceVersion;
+        uint32 RecordSize = sizeof(FRenderStreamTraceFrame);
+        uint32 NumFrames = 0;
+        uint32 NumStreamNames = 0;
+
+        friend FArchive& operator<<(FArchive& Ar, FTraceHeader& Header)
+        {
+            return Ar << Header.Magic << Header.Version << Header.RecordSize << Header.NumFrames << Header.NumStreamNames;
+        }
+    };
+}
+
+FRenderStreamTrace::FRenderStreamTrace(int32 InCapacity)
+{
+    m_frames.SetNumZeroed(FMath::Max(InCapacity, 1));
+}
+
+FRenderStreamTraceFrame& FRenderStreamTrace::BeginRecord()
+{
+    FRenderStreamTraceFrame& Frame = m_frames[m_next];
+    FMemory::Memzero(Frame);
+    Frame.RecordTime = m_lastRecordTime;
+    return Frame;
+}
+
+void FRenderStreamTrace::EndRecord(uint64 StartCycles, uint64 WriteCycles)
+{
+    m_next = (m_next + 1) % m_frames.Num();
+    m_count = FMath::Min(m_count + 1, m_frames.Num());
+
+    m_lastRecordTime = float(FPlatformTime::ToMilliseconds64(WriteCycles + FPlatformTime::Cycles64() - StartCycles));
+    m_maxRecordTime = FMath::Max(m_maxRecordTime, m_lastRecordTime);
+    if (m_lastRecordTime > RecordTimeBudget && !m_warnedRecordTime)
+    {
+        UE_LOG(LogRenderStream, Warning, TEXT("Recording the profiling trace took %.3fms, over the %.1fms budget"), m_lastRecordTime, RecordTimeBudget);
+        m_warnedRecordTime = true;
+    }
+}
+
+bool FRenderStreamTrace::Dump(const FString& Path, const TArray<FString>& StreamNames) const
+{
+    TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Path));
+    if (!Ar)
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Unable to open '%s' to write the profiling trace"), *Path);
+        return false;
+    }
+
+    FTraceHeader Header;
+    Header.NumFrames = m_count;
+    Header.NumStreamNames = StreamNames.Num();
+    *Ar << Header;
+    for (const FString& Name : StreamNames)
+        *Ar << const_cast<FString&>(Name);
+
+    // oldest record first
+    const int32 First = m_count < m_frames.Num() ? 0 : m_next;
+    for (int32 i = 0; i < m_count; ++i)
+        Ar->Serialize(const_cast<FRenderStreamTraceFrame*>(&m_frames[(First + i) % m_frames.Num()]), sizeof(FRenderStreamTraceFrame));
+
+    const bool Success = Ar->Close();
+    if (Success)
+        UE_LOG(LogRenderStream, Log, TEXT("Wrote %d frames of profiling trace to '%s'"), m_count, *Path);
+    else
+        UE_LOG(LogRenderStream, Error, TEXT("Failed writing the profiling trace to '%s'"), *Path);
+    return Success;
+}
+
+bool FRenderStreamTrace::ConvertToChromeTrace(const FString& TracePath, const FString& JsonPath)
+{
+    TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*TracePath));
+    if (!Ar)
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Unable to open profiling trace '%s'"), *TracePath);
+        return false;
+    }
+
+    FTraceHeader Header;
+    *Ar << Header;
+    if (Header.Magic != TraceMagic || Header.Version != TraceVersion || Header.RecordSize != sizeof(FRenderStreamTraceFrame))
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("'%s' is not a profiling trace written by this version of RenderStream"), *TracePath);
+        return false;
+    }
+
+    // Counts from a corrupt file are checked against what is left of it before anything is allocated for them. Every
+    // name is at least its length.
+    auto Remaining = [&Ar]() { return uint64(FMath::Max<int64>(Ar->TotalSize() - Ar->Tell(), 0)); };
+    if (uint64(Header.NumStreamNames) * sizeof(int32) > Remaining())
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Profiling trace '%s' is corrupt, it names %u streams"), *TracePath, Header.NumStreamNames);
+        return false;
+    }
+
+    // A name's own length is bounded the same way.
+    Ar->ArMaxSerializeSize = Ar->TotalSize();
+    TArray<FString> StreamNames;
+    StreamNames.SetNum(Header.NumStreamNames);
+    for (FString& Name : StreamNames)
+        *Ar << Name;
+
+    if (Ar->IsError() || uint64(Header.NumFrames) * Header.RecordSize > Remaining())
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Profiling trace '%s' is corrupt, %u frames do not fit in it"), *TracePath, Header.NumFrames);
+        return false;
+    }
+
+    TArray<FRenderStreamTraceFrame> Frames;
+    Frames.SetNumUninitialized(Header.NumFrames);
+    Ar->Serialize(Frames.GetData(), Frames.Num() * sizeof(FRenderStreamTraceFrame));
+    if (Ar->IsError())
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Profiling trace '%s' is truncated"), *TracePath);
+        return false;
+    }
+
+    enum { FrameTid = 1, UpdateTid = 2, FirstStreamTid = 10 };
+
+    FString Json;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+    auto WriteThreadName = [&Writer](int32 Tid, const FString& Name)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("ph"), TEXT("M"));
+        Writer->WriteValue(TEXT("name"), TEXT("thread_name"));
+        Writer->WriteValue(TEXT("pid"), 1);
+        Writer->WriteValue(TEXT("tid"), Tid);
+        Writer->WriteObjectStart(TEXT("args"));
+        Writer->WriteValue(TEXT("name"), Name);
+        Writer->WriteObjectEnd();
+        Writer->WriteObjectEnd();
+    };
+    // Complete event, times in microseconds. Returns the end so events can be laid out back to back.
+    auto WriteSpan = [&Writer](int32 Tid, const TCHAR* Name, double Start, double Duration)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("ph"), TEXT("X"));
+        Writer->WriteValue(TEXT("name"), Name);
+        Writer->WriteValue(TEXT("pid"), 1);
+        Writer->WriteValue(TEXT("tid"), Tid);
+        Writer->WriteValue(TEXT("ts"), Start);
+        Writer->WriteValue(TEXT("dur"), Duration);
+        Writer->WriteObjectEnd();
+        return Start + Duration;
+    };
+    auto WriteCounter = [&Writer](const FString& Name, double Time, float Value)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("ph"), TEXT("C"));
+        Writer->WriteValue(TEXT("name"), Name);
+        Writer->WriteValue(TEXT("pid"), 1);
+        Writer->WriteValue(TEXT("ts"), Time);
+        Writer->WriteObjectStart(TEXT("args"));
+        Writer->WriteValue(TEXT("ms"), Value);
+        Writer->WriteObjectEnd();
+        Writer->WriteObjectEnd();
+    };
+    auto StreamName = [&StreamNames](uint32 Idx)
+    {
+        return StreamNames.IsValidIndex(Idx) ? StreamNames[Idx] : FString::Printf(TEXT("Stream %u"), Idx);
+    };
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("displayTimeUnit"), TEXT("ms"));
+    Writer->WriteArrayStart(TEXT("traceEvents"));
+
+    WriteThreadName(FrameTid, TEXT("Frames"));
+    WriteThreadName(UpdateTid, TEXT("RenderStream Update"));
+    uint32 MaxStreams = 0;
+    for (const FRenderStreamTraceFrame& Frame : Frames)
+        MaxStreams = FMath::Max(MaxStreams, FMath::Min<uint32>(Frame.NumStreams, FRenderStreamTraceFrame::MaxStreams));
+    for (uint32 i = 0; i < MaxStreams; ++i)
+        WriteThreadName(FirstStreamTid + i, StreamName(i));
+
+    // Only durations are recorded, so the spans within a frame are laid out back to back from its start.
+    const double Origin = Frames.Num() > 0 ? Frames[0].Timestamp - Frames[0].FrameTime / 1000.0 : 0.0;
+    for (const FRenderStreamTraceFrame& Frame : Frames)
+    {
+        const double End = (Frame.Timestamp - Origin) * 1000000.0;
+        const double Start = End - Frame.FrameTime * 1000.0;
+        WriteSpan(FrameTid, *FString::Printf(TEXT("Frame %llu"), Frame.FrameNumber), Start, Frame.FrameTime * 1000.0);
+
+        double Time = Start;
+        if (Frame.AwaitTime > 0)
+            Time = WriteSpan(UpdateTid, TEXT("Await"), Time, Frame.AwaitTime * 1000.0);
+        if (Frame.ReceiveTime > 0)
+            Time = WriteSpan(UpdateTid, TEXT("Receive"), Time, Frame.ReceiveTime * 1000.0);
+        const double SceneStart = Time;
+        Time = WriteSpan(UpdateTid, TEXT("Apply Scene"), Time, Frame.SceneApplyTime * 1000.0);
+        WriteSpan(UpdateTid, TEXT("Apply Parameters"), SceneStart, Frame.ParameterApplyTime * 1000.0);
+        WriteSpan(UpdateTid, TEXT("Apply Cameras"), Time, Frame.CameraApplyTime * 1000.0);
+
+        WriteCounter(TEXT("Game Time"), Start, Frame.GameTime);
+        WriteCounter(TEXT("Render Time"), Start, Frame.RenderTime);
+        WriteCounter(TEXT("RHI Time"), Start, Frame.RHITime);
+        WriteCounter(TEXT("GPU Time"), Start, Frame.GPUTime);
+        WriteCounter(TEXT("Trace Record Time"), Start, Frame.RecordTime);
+
+        const uint32 NumStreams = FMath::Min<uint32>(Frame.NumStreams, FRenderStreamTraceFrame::MaxStreams);
+        for (uint32 i = 0; i < NumStreams; ++i)
+        {
+            const FRenderStreamTraceFrame::FStream& Stream = Frame.Streams[i];
+            // Streams are copied and sent on the render thread, after the game thread has finished the frame.
+            double StreamTime = End;
+            if (Stream.Rendered)
+                StreamTime = WriteSpan(FirstStreamTid + i, TEXT("Copy"), StreamTime, Stream.CopyTime * 1000.0);
+            WriteSpan(FirstStreamTid + i, Stream.Rendered ? TEXT("Send") : TEXT("Resend"), StreamTime, Stream.SendTime * 1000.0);
+            WriteCounter(StreamName(i) + TEXT(" Copy GPU"), Start, Stream.CopyGPUTime);
+        }
+    }
+
+    Writer->WriteArrayEnd();
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    if (!FFileHelper::SaveStringToFile(Json, *JsonPath))
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Unable to write Chrome trace '%s'"), *JsonPath);
+        return false;
+    }
+
+    UE_LOG(LogRenderStream, Log, TEXT("Converted %d frames of profiling trace to '%s'"), Frames.Num(), *JsonPath);
+    return true;
+}
+
+static FAutoConsoleCommand RenderStreamTraceDump(
+    TEXT("rs.trace.dump"),
+    TEXT("Writes the RenderStream profiling trace to a file, defaults to Saved/RenderStream/Trace-<time>.rstrace. Usage: rs.trace.dump [File]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        FRenderStreamModule* Module = FRenderStreamModule::Get();
+        if (!Module->m_trace)
+        {
+            UE_LOG(LogRenderStream, Warning, TEXT("RenderStream is not running, there is no profiling trace to dump"));
+            return;
+        }
+
+        const FString Path = Args.Num() > 0 ? Args[0] : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RenderStream"), FString::Printf(TEXT("Trace-%s.rstrace"), *FDateTime::Now().ToString()));
+        Module->DumpTrace(Path);
+    }));
+
+static FAutoConsoleCommand RenderStreamTraceToJson(
+    TEXT("rs.trace.tojson"),
+    TEXT("Converts a RenderStream profiling trace to Chrome trace JSON. Usage: rs.trace.tojson <TraceFile> [JsonFile]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.Num() < 1)
+        {
+            UE_LOG(LogRenderStream, Warning, TEXT("Usage: rs.trace.tojson <TraceFile> [JsonFile]"));
+            return;
+        }
+
+        const FString JsonPath = Args.Num() > 1 ? Args[1] : FPaths::ChangeExtension(Args[0], TEXT("json"));
+        FRenderStreamTrace::ConvertToChromeTrace(Args[0], JsonPath);
+    }));
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// One frame of timings, all in milliseconds unless stated. Fixed size so the ring never allocates while recording.
+struct FRenderStreamTraceFrame
+{
+    static constexpr int32 MaxStreams = 16;
+
+    struct FStream
+    {
+        float CopyTime;
+        float SendTime;
+        float CopyGPUTime;
+        uint32 Rendered;
+    };
+
+    double Timestamp;     // FPlatformTime::Seconds() at the end of the frame
+    double TrackedTime;   // d3 tracked time of the applied frame, in seconds
+    uint64 FrameNumber;
+    float FrameTime;
+    float GameTime;
+    float RenderTime;
+    float RHITime;
+    float GPUTime;
+    float AwaitTime;
+    float ReceiveTime;
+    float SceneApplyTime;
+    float ParameterApplyTime;
+    float CameraApplyTime;
+    float RecordTime;     // cost of recording the previous frame
+    uint32 NumStreams;
+    FStream Streams[MaxStreams]; // indexed by projection policy
+};
+
+// Always-on fixed-memory ring of per-frame timings, so a bad stretch of a show can be reconstructed on the node.
+// Recorded and dumped from the game thread only.
+class FRenderStreamTrace
+{
+public:
+    explicit FRenderStreamTrace(int32 InCapacity);
+
+    // Returns the slot for the next frame, zeroed, overwriting the oldest record once the ring is full.
+    FRenderStreamTraceFrame& BeginRecord();
+    // Commits the slot from BeginRecord. The cost of recording is the cycles spent writing the slot before this call
+    // plus those since StartCycles, reported with the next frame.
+    void EndRecord(uint64 StartCycles, uint64 WriteCycles);
+
+    SIZE_T AllocatedSize() const { return m_frames.GetAllocatedSize(); }
+
+    float LastRecordTime() const { return m_lastRecordTime; }
+    float MaxRecordTime() const { return m_maxRecordTime; }
+
+    // Writes the records oldest first with a small header and the stream names, see RenderStreamTrace.cpp.
+    bool Dump(const FString& Path, const TArray<FString>& StreamNames) const;
+    // Converts a file written by Dump to Chrome trace JSON (chrome://tracing, Perfetto).
+    static bool ConvertToChromeTrace(const FString& TracePath, const FString& JsonPath);
+
+private:
+    TArray<FRenderStreamTraceFrame> m_frames;
+    int32 m_next = 0;
+    int32 m_count = 0;
+    float m_lastRecordTime = 0.f;
+    float m_maxRecordTime = 0.f;
+    bool m_warnedRecordTime = false;
+};
@@ -3,6 +3,7 @@
 #include "Camera/CameraActor.h"
 #include "RenderStreamChannelDefinition.h"
 #include "RenderStreamProjectionPolicy.h"
+#include "RenderStream.h"
 #include "Render/Device/DisplayClusterRenderViewport.h"
 #include "Render/Device/IDisplayClusterRenderDevice.h"
 #include "IDisplayCluster.h"
@@ -167,10 +168,20 @@ void URenderStreamViewportClient::Draw(FViewport* InViewport, FCanvas* SceneCanv
     /// !!!! disguise customizations
     IDisplayClusterRenderManager* RenderMgr = IDisplayCluster::Get().GetRenderMgr();
     const FRenderStreamProjectionPolicyFactory* RenderStreamFactory = static_cast<FRenderStreamProjectionPolicyFactory*>(RenderMgr->GetProjectionPolicyFactory(FRenderStreamProjectionPolicyFactory::RenderStreamPolicyType).Get());
+    const FRenderStreamModule* RenderStreamModule = FRenderStreamModule::Get();
     /// !!!! disguise customizations
 
     for (int32 ViewFamilyIdx = 0; ViewFamilyIdx < NumFamilies; ++ViewFamilyIdx)
     {
+        /// !!!! disguise customizations
+        // Render on demand, views for streams d3 did not request this frame, or skipped by the stream's
+        // frame-rate divisor, are not rendered.
+        if (!RenderStreamModule->IsStreamRendered(ViewFamilyIdx))
+        {
+            continue;
+        }
+        /// !!!! disguise customizations
+
         // Create the view family for rendering the world scene to the viewport's render target
         FSceneViewFamilyContext ViewFamily(FSceneViewFamily::ConstructionValues(InViewport, MyWorld->Scene, EngineShowFlags)
             .SetRealtimeUpdate(true)
@@ -645,17 +656,7 @@ void URenderStreamViewportClient::FinalizeViewFamily(int32 ViewFamilyIdx, FScene
         {
             // This only really works if we have a single view per view family which is currently the case in nDisplay.
             ViewFamily->EngineShowFlags = Definition->ShowFlags;
-            const TArray<TWeakObjectPtr<AActor>> Actors = Definition->DefaultVisibility == EVisibilty::Visible ? Definition->Hidden : Definition->Visible;
-            for (const TWeakObjectPtr<AActor> Actor : Actors)
-            {
-                if (Actor.IsValid())
-                {
-                    Actor->ForEachComponent<UPrimitiveComponent>(false, [&Collection](const UPrimitiveComponent* PrimativeComponent)
-                    {
-                        Collection.Add(PrimativeComponent->ComponentId);
-                    });
-                }
-            }
+            Definition->GetFilteredPrimitives(Collection);
 
             if (Definition->DefaultVisibility == EVisibilty::Visible)
                 View->HiddenPrimitives = Collection;
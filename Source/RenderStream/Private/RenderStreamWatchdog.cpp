@@ -0,0 +1,175 @@
+#include "RenderStreamWatchdog.h"
+
+#include "RenderStream.h"
+#include "RenderStreamMonitor.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+// How often the watchdog looks at the paths, stalls are detected up to this late.
+static constexpr double CheckInterval = 0.1;
+static constexpr SIZE_T MaxStackDump = 16 * 1024;
+
+static const TCHAR* HeartbeatName(ERenderStreamHeartbeat Path)
+{
+    switch (Path)
+    {
+    case ERenderStreamHeartbeat::Sync: return TEXT("Sync");
+    case ERenderStreamHeartbeat::Send: return TEXT("Send");
+    case ERenderStreamHeartbeat::GameThread: return TEXT("Game thread");
+    default: return TEXT("Unknown");
+    }
+}
+
+FRenderStreamWatchdog::~FRenderStreamWatchdog()
+{
+    if (m_thread)
+        Close();
+}
+
+void FRenderStreamWatchdog::Open(const float (&Thresholds)[uint8(ERenderStreamHeartbeat::Num)], bool bInRecreateStalledStreams)
+{
+    bool bAny = false;
+    for (uint8 i = 0; i < uint8(ERenderStreamHeartbeat::Num); ++i)
+    {
+        m_heartbeats[i].Threshold = Thresholds[i] > 0.f ? uint64(Thresholds[i] / FPlatformTime::GetSecondsPerCycle64()) : 0;
+        bAny |= m_heartbeats[i].Threshold != 0;
+    }
+    m_recreateStalledStreams = bInRecreateStalledStreams;
+    if (!bAny || m_thread)
+        return;
+
+    m_stop = false;
+    m_wake = FPlatformProcess::GetSynchEventFromPool(false);
+    m_thread = FRunnableThread::Create(this, TEXT("RenderStreamWatchdog"), 0, TPri_AboveNormal);
+}
+
+void FRenderStreamWatchdog::Close()
+{
+    if (!m_thread)
+        return;
+
+    m_thread->Kill(true);
+    delete m_thread;
+    m_thread = nullptr;
+
+    FPlatformProcess::ReturnSynchEventToPool(m_wake);
+    m_wake = nullptr;
+    RenderStreamMonitor().ClearStatus(ERenderStreamStatusSource::Stall);
+}
+
+void FRenderStreamWatchdog::Enter(ERenderStreamHeartbeat Path, const TCHAR* Location, const TCHAR* Context)
+{
+    FHeartbeat& Heartbeat = m_heartbeats[uint8(Path)];
+    Heartbeat.Location.store(Location, std::memory_order_relaxed);
+    Heartbeat.Context.store(Context, std::memory_order_relaxed);
+    Heartbeat.ThreadId.store(FPlatformTLS::GetCurrentThreadId(), std::memory_order_relaxed);
+    Heartbeat.EnterCycles.store(FPlatformTime::Cycles64(), std::memory_order_release);
+}
+
+void FRenderStreamWatchdog::SetLocation(ERenderStreamHeartbeat Path, const TCHAR* Location)
+{
+    m_heartbeats[uint8(Path)].Location.store(Location, std::memory_order_relaxed);
+}
+
+bool FRenderStreamWatchdog::Leave(ERenderStreamHeartbeat Path)
+{
+    FHeartbeat& Heartbeat = m_heartbeats[uint8(Path)];
+    uint64 EnterCycles = 0;
+    uint64 StalledCycles = 0;
+    {
+        FScopeLock Lock(&Heartbeat.StallLock);
+        EnterCycles = Heartbeat.EnterCycles.exchange(0, std::memory_order_relaxed);
+        StalledCycles = Heartbeat.StalledCycles.exchange(0, std::memory_order_relaxed);
+    }
+    if (StalledCycles != EnterCycles || EnterCycles == 0)
+        return false;
+
+    const double Duration = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - EnterCycles);
+    const TCHAR* Context = Heartbeat.Context.load(std::memory_order_relaxed);
+    UE_LOG(LogRenderStream, Warning, TEXT("%s stall in %s%s%s recovered after %.2f s"), HeartbeatName(Path), Heartbeat.Location.load(std::memory_order_relaxed),
+        Context ? TEXT(" for ") : TEXT(""), Context ? Context : TEXT(""), Duration);
+    if (m_wake)
+        m_wake->Trigger(); // update d3's status now rather than on the next check
+    return m_recreateStalledStreams && Path == ERenderStreamHeartbeat::Send;
+}
+
+FRenderStreamWatchdog::FScope::FScope(ERenderStreamHeartbeat InPath, const TCHAR* Location, const TCHAR* Context)
+    : Path(InPath)
+{
+    RenderStreamWatchdog().Enter(Path, Location, Context);
+}
+
+FRenderStreamWatchdog::FScope::~FScope()
+{
+    RenderStreamWatchdog().Leave(Path);
+}
+
+uint32 FRenderStreamWatchdog::Run()
+{
+    FString Sent;
+    while (!m_stop)
+    {
+        m_wake->Wait(FTimespan::FromSeconds(CheckInterval));
+
+        FString Status;
+        const uint64 Now = FPlatformTime::Cycles64();
+        for (uint8 i = 0; i < uint8(ERenderStreamHeartbeat::Num); ++i)
+        {
+            FHeartbeat& Heartbeat = m_heartbeats[i];
+            const uint64 EnterCycles = Heartbeat.EnterCycles.load(std::memory_order_acquire);
+            if (Heartbeat.Threshold == 0 || EnterCycles == 0 || Now < EnterCycles || Now - EnterCycles < Heartbeat.Threshold)
+                continue;
+
+            if (Heartbeat.StalledCycles.load(std::memory_order_relaxed) != EnterCycles)
+            {
+                // Reported under the lock, so Leave logs the recovery after it and the stack is still the stalled one.
+                FScopeLock Lock(&Heartbeat.StallLock);
+                if (Heartbeat.EnterCycles.load(std::memory_order_relaxed) != EnterCycles)
+                    continue; // left since it was read
+                Heartbeat.StalledCycles.store(EnterCycles, std::memory_order_relaxed);
+                Report(ERenderStreamHeartbeat(i), FPlatformTime::ToSeconds64(Now - EnterCycles));
+            }
+
+            if (!Status.IsEmpty())
+                Status += TEXT(", ");
+            Status += FString::Printf(TEXT("%s stalled in %s"), HeartbeatName(ERenderStreamHeartbeat(i)), Heartbeat.Location.load(std::memory_order_relaxed));
+        }
+
+        if (Status != Sent)
+        {
+            RenderStreamMonitor().SetStatus(ERenderStreamStatusSource::Stall, Status);
+            Sent = Status;
+        }
+    }
+    return 0;
+}
+
+void FRenderStreamWatchdog::Stop()
+{
+    m_stop = true;
+    m_wake->Trigger();
+}
+
+void FRenderStreamWatchdog::Report(ERenderStreamHeartbeat Path, double Duration)
+{
+    const FHeartbeat& Heartbeat = m_heartbeats[uint8(Path)];
+    const TCHAR* Context = Heartbeat.Context.load(std::memory_order_relaxed);
+    UE_LOG(LogRenderStream, Error, TEXT("%s stalled in %s%s%s for %.2f s"), HeartbeatName(Path), Heartbeat.Location.load(std::memory_order_relaxed),
+        Context ? TEXT(" for ") : TEXT(""), Context ? Context : TEXT(""), Duration);
+
+    // The stalled thread is stopped where it hangs, so its stack shows which call did not return.
+    TArray<ANSICHAR> Stack;
+    Stack.AddZeroed(MaxStackDump);
+    FPlatformStackWalk::ThreadStackWalkAndDump(Stack.GetData(), Stack.Num(), 0, Heartbeat.ThreadId.load(std::memory_order_relaxed));
+    UE_LOG(LogRenderStream, Error, TEXT("Call stack of the stalled thread:\n%s"), ANSI_TO_TCHAR(Stack.GetData()));
+}
+
+FRenderStreamWatchdog& RenderStreamWatchdog()
+{
+    static FRenderStreamWatchdog Watchdog;
+    return Watchdog;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+// The paths the watchdog times, each is entered and left by one thread at a time.
+enum class ERenderStreamHeartbeat : uint8
+{
+    Sync,       // awaiting or receiving frame data from d3, game thread
+    Send,       // sending a stream's frame to d3, rendering thread
+    GameThread, // a game thread frame, from begin to end
+    Num
+};
+
+// Watches the paths which would leave d3 without frames while the process still looks alive: a call into the
+// RenderStream library or the GPU which never returns freezes its thread. A path inside longer than its threshold is
+// reported once to the log with the stalled thread's call stack and to d3's status through the monitor, and again when
+// it recovers. Stalls of the send path can recreate the stream's resources once the send returns.
+class FRenderStreamWatchdog : public FRunnable
+{
+public:
+    virtual ~FRenderStreamWatchdog();
+
+    // Thresholds in seconds, 0 disables the path.
+    void Open(const float (&Thresholds)[uint8(ERenderStreamHeartbeat::Num)], bool bInRecreateStalledStreams);
+    void Close();
+
+    // Cheap enough to call every frame: a few relaxed atomic writes, and an uncontended lock in Leave. Location and
+    // Context must outlive the scope.
+    void Enter(ERenderStreamHeartbeat Path, const TCHAR* Location, const TCHAR* Context = nullptr);
+    // Moves a path which is already inside to a new location, so a report says which call stalled.
+    void SetLocation(ERenderStreamHeartbeat Path, const TCHAR* Location);
+    // Returns true when the path stalled since Enter and the stalled work should be recovered.
+    bool Leave(ERenderStreamHeartbeat Path);
+
+    struct FScope
+    {
+        FScope(ERenderStreamHeartbeat InPath, const TCHAR* Location, const TCHAR* Context = nullptr);
+        ~FScope();
+
+        ERenderStreamHeartbeat Path;
+    };
+
+private:
+    /** FRunnable implementation */
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+    void Report(ERenderStreamHeartbeat Path, double Duration);
+
+    struct FHeartbeat
+    {
+        std::atomic<uint64> EnterCycles { 0 }; // 0 when outside
+        std::atomic<const TCHAR*> Location { nullptr };
+        std::atomic<const TCHAR*> Context { nullptr };
+        std::atomic<uint32> ThreadId { 0 };
+        std::atomic<uint64> StalledCycles { 0 }; // EnterCycles of the reported stall, so a stall is never matched to a later Enter
+        FCriticalSection StallLock; // a stall is reported or left, never both at once
+        uint64 Threshold = 0; // in cycles
+    };
+    FHeartbeat m_heartbeats[uint8(ERenderStreamHeartbeat::Num)];
+    bool m_recreateStalledStreams = false;
+
+    FRunnableThread* m_thread = nullptr;
+    FEvent* m_wake = nullptr;
+    std::atomic<bool> m_stop { false };
+};
+
+FRenderStreamWatchdog& RenderStreamWatchdog();
@@ -1,4 +1,5 @@
 #include "SceneSelector_Maps.h"
+#include "RenderStreamMonitor.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 
@@ -14,11 +15,12 @@ void SceneSelector_Maps::ApplyScene(const UWorld& world, uint32_t sceneId)
 
     if (world.GetName() != map.Name)
     {
-
+        RenderStreamMonitor().SetStatus(ERenderStreamStatusSource::Loading, TEXT("Loading map ") + map.Name);
         UGameplayStatics::OpenLevel(&world, FName(map.Name));
     }
     else
     {
+        RenderStreamMonitor().ClearStatus(ERenderStreamStatusSource::Loading);
         AActor* persistentRoot = world.PersistentLevel->GetLevelScriptActor();
 
         switch (map.ValidationState)
@@ -0,0 +1,113 @@
+#include "SceneSelector_ResidentLevels.h"
+#include "RenderStream.h"
+#include "RenderStreamMonitor.h"
+#include "Engine/World.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/LevelStreamingAlwaysLoaded.h"
+
+// Unloaded levels only release their memory after garbage collection, so evictions are spaced out to see it drop.
+static constexpr double EvictionInterval = 2.0;
+
+SceneSelector_ResidentLevels::SceneSelector_ResidentLevels(int32 InMemoryBudgetMB)
+    : m_memoryBudget(uint64(FMath::Max(InMemoryBudgetMB, 0)) * 1024 * 1024)
+{}
+
+bool SceneSelector_ResidentLevels::OnLoadedSchema(const UWorld& World, const RenderStreamLink::Schema& Schema)
+{
+    m_shownScene = UINT32_MAX;
+    m_lastShown.assign(Schema.scenes.nScenes, 0.0);
+    return SceneSelector_StreamingLevels::OnLoadedSchema(World, Schema);
+}
+
+void SceneSelector_ResidentLevels::ApplyScene(const UWorld& World, uint32_t sceneId)
+{
+    if (sceneId >= m_specs.size())
+    {
+        UE_LOG(LogRenderStream, Error, TEXT("Unable to get frame parameters - scene id %d >= %d"), sceneId, m_specs.size());
+        return;
+    }
+
+    SchemaSpec& spec = m_specs[sceneId];
+    if (spec.streamingLevel && !spec.streamingLevel->IsLevelLoaded())
+    {
+        // Keep the shown scene running until the new one can be shown.
+        if (!spec.streamingLevel->ShouldBeLoaded())
+        {
+            UE_LOG(LogRenderStream, Log, TEXT("Loading level %s in the background"), *spec.streamingLevel->GetWorldAssetPackageFName().ToString());
+            spec.streamingLevel->SetShouldBeLoaded(true);
+            spec.streamingLevel->SetShouldBeVisible(false);
+            RenderStreamMonitor().SetStatus(ERenderStreamStatusSource::Loading, TEXT("Loading level ") + spec.streamingLevel->GetWorldAssetPackageFName().ToString());
+        }
+        if (m_shownScene < m_specs.size() && m_shownScene != sceneId)
+            ShowScene(World, m_shownScene);
+        return;
+    }
+
+    RenderStreamMonitor().ClearStatus(ERenderStreamStatusSource::Loading);
+    if (!spec.loaded)
+    {
+        spec.loaded = true;
+        ValidateLevel(sceneId);
+    }
+
+    ShowScene(World, sceneId);
+    EnforceBudget(sceneId);
+}
+
+void SceneSelector_ResidentLevels::ShowScene(const UWorld& World, uint32_t sceneId)
+{
+    const SchemaSpec& spec = m_specs[sceneId];
+
+    // Adding a level to the world is time sliced over several frames, the scene shown until now stays on screen
+    // until the new one is visible rather than leaving nothing to render.
+    const bool Visible = !spec.streamingLevel || spec.streamingLevel->IsLevelVisible();
+    const ULevelStreaming* Previous = !Visible && m_shownScene < m_specs.size() ? m_specs[m_shownScene].streamingLevel : nullptr;
+    for (ULevelStreaming* streamingLevel : World.GetStreamingLevels())
+    {
+        // Hidden levels are only removed from the world, they stay loaded until evicted.
+        const bool Shown = streamingLevel == spec.streamingLevel || (Previous && streamingLevel == Previous);
+        if (streamingLevel->ShouldBeVisible() != Shown)
+            streamingLevel->SetShouldBeVisible(Shown);
+    }
+
+    if (!Visible)
+        return;
+
+    m_shownScene = sceneId;
+    m_lastShown[sceneId] = FPlatformTime::Seconds();
+
+    if (!spec.streamingLevel)
+        ApplyParameters(sceneId, { spec.persistentRoot });
+    else
+        ApplyParameters(sceneId, { spec.persistentRoot, spec.streamingLevel->GetLevelScriptActor() });
+}
+
+void SceneSelector_ResidentLevels::EnforceBudget(uint32_t sceneId)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (m_memoryBudget == 0 || Now - m_lastEviction < EvictionInterval || FPlatformMemory::GetStats().UsedPhysical <= m_memoryBudget)
+        return;
+
+    // Least recently shown level this selector made resident, never one on screen or becoming visible. Always loaded
+    // levels ignore being unloaded, so they are never candidates.
+    int32 Oldest = INDEX_NONE;
+    for (int32 i = 0; i < int32(m_specs.size()); ++i)
+    {
+        ULevelStreaming* streamingLevel = m_specs[i].streamingLevel;
+        if (uint32_t(i) == sceneId || m_lastShown[i] <= 0.0 || !streamingLevel || streamingLevel->IsA<ULevelStreamingAlwaysLoaded>() ||
+            !streamingLevel->ShouldBeLoaded() || streamingLevel->ShouldBeVisible() || streamingLevel == m_specs[sceneId].streamingLevel)
+            continue;
+        if (Oldest == INDEX_NONE || m_lastShown[i] < m_lastShown[Oldest])
+            Oldest = i;
+    }
+    if (Oldest == INDEX_NONE)
+        return;
+
+    ULevelStreaming* streamingLevel = m_specs[Oldest].streamingLevel;
+    UE_LOG(LogRenderStream, Log, TEXT("Over the %llu MB scene memory budget, unloading level %s"), m_memoryBudget / (1024 * 1024), *streamingLevel->GetWorldAssetPackageFName().ToString());
+    streamingLevel->SetShouldBeVisible(false);
+    streamingLevel->SetShouldBeLoaded(false);
+    m_lastShown[Oldest] = 0.0;
+    m_specs[Oldest].loaded = false; // validated again once reloaded
+    m_lastEviction = Now;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "SceneSelector_StreamingLevels.h"
+
+// Scenes are the persistent level and its streaming levels, as with SceneSelector_StreamingLevels, but levels stay
+// loaded once shown so switching back is a visibility change. A scene which is not loaded yet loads in the background
+// while the previous scene stays on screen. Over the memory budget, the least recently shown levels are unloaded.
+class SceneSelector_ResidentLevels : public SceneSelector_StreamingLevels
+{
+public:
+    // Budget of the process's physical memory in megabytes, 0 keeps every level loaded.
+    explicit SceneSelector_ResidentLevels(int32 InMemoryBudgetMB);
+
+    void ApplyScene(const UWorld& world, uint32_t sceneId) override;
+
+protected:
+    bool OnLoadedSchema(const UWorld& World, const RenderStreamLink::Schema& Schema) override;
+
+private:
+    void ShowScene(const UWorld& World, uint32_t sceneId);
+    void EnforceBudget(uint32_t sceneId);
+
+    uint64 m_memoryBudget = 0;
+    uint32_t m_shownScene = UINT32_MAX;
+    std::vector<double> m_lastShown; // per scene, 0 when not resident
+    double m_lastEviction = 0;
+};
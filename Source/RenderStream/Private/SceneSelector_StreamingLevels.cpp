@@ -1,4 +1,5 @@
 #include "SceneSelector_StreamingLevels.h"
+#include "RenderStreamMonitor.h"
 #include "Containers/UnrealString.h"
 #include "Engine/World.h"
 #include "Engine/LevelStreaming.h"
@@ -66,10 +67,12 @@ void SceneSelector_StreamingLevels::ApplyScene(const UWorld& World, uint32_t sce
             UE_LOG(LogRenderStream, Log, TEXT("Loading level %s"), *spec.streamingLevel->GetWorldAssetPackageFName().ToString());
             FLatentActionInfo LatentInfo;
             UGameplayStatics::LoadStreamLevel(&World, spec.streamingLevel->GetWorldAssetPackageFName(), true, true, LatentInfo);
+            RenderStreamMonitor().SetStatus(ERenderStreamStatusSource::Loading, TEXT("Loading level ") + spec.streamingLevel->GetWorldAssetPackageFName().ToString());
             return;
         }
         else
         {
+            RenderStreamMonitor().ClearStatus(ERenderStreamStatusSource::Loading);
             spec.loaded = true;
             ValidateLevel(sceneId);
         }
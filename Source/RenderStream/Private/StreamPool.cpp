@@ -1,16 +1,64 @@
 #include "StreamPool.h"
 #include "FrameStream.h"
+#include "RenderStream.h"
+#include "RenderStreamMemory.h"
+
+#include "Async/ParallelFor.h"
+
+int32 FStreamPool::AddNewStreamsToPool(const TArray<FStreamDescription>& Descriptions)
+{
+    RS_LLM_SCOPE(ERenderStreamMemory::Streams);
+    TArray<TSharedPtr<FFrameStream>> Streams;
+    TArray<bool> Created;
+    Streams.Reserve(Descriptions.Num());
+    Created.Init(false, Descriptions.Num());
+    for (const FStreamDescription& Description : Descriptions)
+    {
+        TSharedPtr<FFrameStream> Stream = MakeShared<FFrameStream>();
+        Stream->SetupHeadless(Description.Name, Description.Resolution, Description.Channel, Description.Clipping, Description.Handle);
+        Streams.Add(Stream);
+    }
+
+    // Committed resources dominate setup with many streams and the device creates them free threaded.
+    ParallelFor(Streams.Num(), [&Streams, &Descriptions, &Created](int32 Index)
+    {
+        Created[Index] = Streams[Index]->CreateNativeResources_AnyThread(Descriptions[Index].Format);
+    });
+
+    // The RHI is only told about the textures here, on the calling thread.
+    int32 NumAdded = 0;
+    for (int32 Index = 0; Index < Streams.Num(); ++Index)
+    {
+        const FStreamDescription& Description = Descriptions[Index];
+        const TSharedPtr<FFrameStream>& Stream = Streams[Index];
+        if (!Created[Index] || !Stream->FinishSetup(Description.Format))
+        {
+            UE_LOG(LogRenderStream, Error, TEXT("Failed to create stream '%s': %s"), *Description.Name, *Stream->SetupError());
+            continue;
+        }
+        UE_LOG(LogRenderStream, Log, TEXT("Created stream '%s'"), *Description.Name);
+        m_pool.Add(Stream);
+        ++NumAdded;
+    }
+    return NumAdded;
+}
 
 bool FStreamPool::AddNewStreamToPool(const FString& StreamName, const FIntPoint& Resolution, const FString& Channel, const RenderStreamLink::ProjectionClipping& Clipping, RenderStreamLink::StreamHandle Handle, RenderStreamLink::RSPixelFormat Fmt)
 {
+    RS_LLM_SCOPE(ERenderStreamMemory::Streams);
     TSharedPtr<FFrameStream> stream = MakeShared<FFrameStream>();
     if (!stream->Setup(StreamName, Resolution, Channel, Clipping, Handle, Fmt))
         return false;
 
-    m_pool.Add(stream);
+    AddStreamToPool(stream);
     return true;
 }
 
+void FStreamPool::AddStreamToPool(const TSharedPtr<FFrameStream>& Stream)
+{
+    m_pool.Add(Stream);
+}
+
 TSharedPtr<FFrameStream> FStreamPool::GetStream(const FString& desiredStreamName)
 {
     auto It = m_pool.FindByPredicate([&desiredStreamName](const TSharedPtr<FFrameStream>& stream) {
@@ -49,6 +97,14 @@ const TMap<uint32, TSharedPtr<FFrameStream>>& FStreamPool::GetActiveStreams() co
     return m_allocated;
 }
 
+TArray<TSharedPtr<FFrameStream>> FStreamPool::GetAllStreams() const
+{
+    TArray<TSharedPtr<FFrameStream>> streams = m_pool;
+    for (const auto& allocated : m_allocated)
+        streams.Add(allocated.Value);
+    return streams;
+}
+
 uint32_t FStreamPool::PoolCount() const
 {
     return m_pool.Num();
@@ -2,8 +2,10 @@
 
 #include "RenderStreamLink.h"
 #include "RenderStreamStatus.h"
+#include "RenderStreamMonitor.h"
 #include "RenderStream.h"
 #include "RenderStreamStats.h"
+#include "RenderStreamWatchdog.h"
 
 bool FRenderStreamSyncFrameData::IsActive() const
 {
@@ -47,10 +49,11 @@ bool FRenderStreamSyncFrameData::Map(FArchive& Ar)
 
     int rsMajorVersion = RENDER_STREAM_VERSION_MAJOR;
     int rsMinorVersion = RENDER_STREAM_VERSION_MINOR;
-    static const int DATA_VERSION = 1;
+    static const int DATA_VERSION = 3;
     int v = DATA_VERSION;
     Ar << rsMajorVersion;
     Ar << rsMinorVersion;
+    Ar << v;
     if (!bIsSaving)
     {
         if (rsMajorVersion != RENDER_STREAM_VERSION_MAJOR ||
@@ -68,6 +71,14 @@ bool FRenderStreamSyncFrameData::Map(FArchive& Ar)
     Ar << m_frameDataValid;
     Ar.Serialize(&m_frameData, sizeof(RenderStreamLink::FrameData));
 
+    // The whole assignment every frame, so a follower which joins late or restarts picks it up straight away.
+    Ar << m_assignment.Version;
+    Ar << m_assignment.Streams;
+
+    Ar << m_dmx.Hash;
+    Ar << m_dmx.Indices;
+    Ar << m_dmx.Values;
+
     return true;
 }
 
@@ -75,7 +86,11 @@ void FRenderStreamSyncFrameData::ControllerReceive()
 {
     SCOPE_CYCLE_COUNTER(STAT_AwaitFrame);
     const double StartTime = FPlatformTime::Seconds();
-    const RenderStreamLink::RS_ERROR Ret = RenderStreamLink::instance().rs_awaitFrameData(500, &m_frameData);
+    RenderStreamLink::RS_ERROR Ret;
+    {
+        FRenderStreamWatchdog::FScope Watch(ERenderStreamHeartbeat::Sync, TEXT("rs_awaitFrameData"));
+        Ret = RenderStreamLink::instance().rs_awaitFrameData(500, &m_frameData);
+    }
 
     if (Ret == RenderStreamLink::RS_ERROR_STREAMS_CHANGED)
     {
@@ -86,7 +101,7 @@ void FRenderStreamSyncFrameData::ControllerReceive()
     {
         if (Ret == RenderStreamLink::RS_ERROR_TIMEOUT)
         {
-            RenderStreamLink::instance().rs_setNewStatusMessage("Not requested");
+            RenderStreamMonitor().SetStatus(ERenderStreamStatusSource::Requests, TEXT("Not requested"));
         }
         else
         {
@@ -101,7 +116,7 @@ void FRenderStreamSyncFrameData::ControllerReceive()
     {
         if (!m_frameDataValid)
         {
-            RenderStreamLink::instance().rs_setNewStatusMessage("");
+            RenderStreamMonitor().ClearStatus(ERenderStreamStatusSource::Requests);
             RenderStreamStatus().Input("Receiving data from d3", RSSTATUS_GREEN);
         }
 
@@ -125,6 +140,7 @@ void FRenderStreamSyncFrameData::ControllerReceive()
 
         m_frameDataValid = true;
         Apply();
+        m_dmx = RenderStreamDmxReceiver().MergedValues();
     }
 
     AwaitTime = (FPlatformTime::Seconds() - StartTime) * 1000.f;
@@ -136,14 +152,20 @@ void FRenderStreamSyncFrameData::FollowerReceive() const
     const double StartTime = FPlatformTime::Seconds();
     // We have been given the frameData the controller node is using for this synchronised frame.
     // We must now let RenderStream know this is the frame we are processing, so that RS APIs give the correct data.
-    RenderStreamLink::instance().rs_setFollower(1);
-    if (m_frameDataValid)
     {
-        RenderStreamLink::instance().rs_beginFollowerFrame(m_frameData.tTracked);
+        FRenderStreamWatchdog::FScope Watch(ERenderStreamHeartbeat::Sync, TEXT("rs_setFollower"));
+        RenderStreamLink::instance().rs_setFollower(1);
+        if (m_frameDataValid)
+        {
+            RenderStreamWatchdog().SetLocation(ERenderStreamHeartbeat::Sync, TEXT("rs_beginFollowerFrame"));
+            RenderStreamLink::instance().rs_beginFollowerFrame(m_frameData.tTracked);
+        }
+    }
 
-        // Write into the engine for this node.
+    // Write into the engine for this node.
+    RenderStreamDmxReceiver().SetMergedValues(m_dmx);
+    if (m_frameDataValid)
         Apply();
-    }
 
     ReceiveTime = (FPlatformTime::Seconds() - StartTime) * 1000.f;
 }
@@ -151,6 +173,11 @@ void FRenderStreamSyncFrameData::FollowerReceive() const
 void FRenderStreamSyncFrameData::Apply() const
 {
     FRenderStreamModule* Module = FRenderStreamModule::Get();
+    if (m_assignment.Version != m_appliedAssignmentVersion)
+    {
+        Module->ApplyStreamAssignment(m_assignment);
+        m_appliedAssignmentVersion = m_assignment.Version;
+    }
     Module->ApplyScene(m_frameData.scene);
     Module->ApplyCameras(m_frameData);
 }
@@ -2,6 +2,8 @@
 
 #include "Cluster/IDisplayClusterClusterSyncObject.h"
 #include "RenderStreamLink.h"
+#include "RenderStreamClusterScheduler.h"
+#include "RenderStreamDmx.h"
 
 class FRenderStreamSyncFrameData : public IDisplayClusterClusterSyncObject
 {
@@ -27,4 +29,11 @@ public:
     double LastTrackedTime = std::numeric_limits<double>::quiet_NaN();
     double AwaitTime = 0;
     mutable double ReceiveTime = 0;
+
+    // Set by the cluster scheduler on the controller, sent to the followers every frame and applied when it changes.
+    FRenderStreamAssignment m_assignment;
+    mutable uint32 m_appliedAssignmentVersion = 0;
+
+    // The parameters DMX drives this frame, merged on the controller and applied by the followers.
+    FRenderStreamDmxValues m_dmx;
 };
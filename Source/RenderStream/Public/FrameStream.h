@@ -5,6 +5,9 @@
 #include "RHI.h"
 #include "RHIResources.h"
 
+#include <atomic>
+#include <string>
+
 class FRHICommandListImmediate;
 
 class FFrameStream
@@ -18,7 +21,25 @@ public:
                                    FRHITexture2D* InSourceTexture,
                                    const FIntRect& ViewportRect);
 
+    // Send the last copied frame again, used when the view was not rendered this frame.
+    void ResendFrame_RenderingThread(FRHICommandListImmediate& RHICmdList, RenderStreamLink::CameraResponseData& FrameData);
+
+    // Clear the stream's texture and create its copy PSO and timing queries ahead of the first frame.
+    void WarmUp_RenderingThread(FRHICommandListImmediate& RHICmdList);
+
+    // Replace the stream's texture and fence, after a send stalled and may have left them in use by d3.
+    void RecreateResources_RenderingThread(FRHICommandListImmediate& RHICmdList);
+
     bool Setup(const FString& Name, const FIntPoint& Resolution, const FString& Channel, const RenderStreamLink::ProjectionClipping& Clipping, RenderStreamLink::StreamHandle Handle, RenderStreamLink::RSPixelFormat Fmt);
+    // The description part of Setup without creating any GPU resources, for CPU-only benchmarks. Frames can not be sent.
+    bool SetupHeadless(const FString& Name, const FIntPoint& Resolution, const FString& Channel, const RenderStreamLink::ProjectionClipping& Clipping, RenderStreamLink::StreamHandle Handle);
+    // The GPU part of Setup in two steps, after SetupHeadless, so the pool can set up many streams at once.
+    // CreateNativeResources_AnyThread makes the device calls and can run on any thread, concurrently with other streams.
+    bool CreateNativeResources_AnyThread(RenderStreamLink::RSPixelFormat Fmt);
+    // Creates the RHI texture from the native resources, on the thread which owns the stream.
+    bool FinishSetup(RenderStreamLink::RSPixelFormat Fmt);
+    // Why the last step of setup failed, empty if it did not.
+    const FString& SetupError() const { return m_setupError; }
 
     const FString& Name() const { return m_streamName;}
     const FString& Channel() const { return m_channel; }
@@ -26,13 +47,54 @@ public:
     FIntPoint Resolution() const { return m_resolution; }
     RenderStreamLink::StreamHandle Handle() const { return m_handle; }
 
+    // Bytes of the stream's texture, and of the stream's own CPU state.
+    uint64 GPUMemory() const { return m_gpuMemory; }
+    uint64 CPUMemory() const;
+
+    // Timings of the last frame in milliseconds, written on the rendering thread.
+    float CopyTime() const { return m_copyTime.load(std::memory_order_relaxed); }
+    float SendTime() const { return m_sendTime.load(std::memory_order_relaxed); }
+    const char* CopyTimeStatName() const { return m_copyTimeStatName.c_str(); }
+    const char* SendTimeStatName() const { return m_sendTimeStatName.c_str(); }
+    // GPU time of the copy pass, read back asynchronously so it lags the current frame by a few frames.
+    float CopyGPUTime() const { return m_copyGPUTime.load(std::memory_order_relaxed); }
+    const char* CopyGPUTimeStatName() const { return m_copyGPUTimeStatName.c_str(); }
+
 private:
+    void ResolveGPUTimings_RenderingThread();
+    // The fence, and the texture when FinishSetup did not hand it to the RHI.
+    void ReleaseNativeResources();
+
     FString m_streamName;
     FString m_channel;
     RenderStreamLink::ProjectionClipping m_clipping;
     FTextureRHIRef m_bufTexture;
-    ID3D12Fence* m_fence;
+    ID3D12Fence* m_fence = nullptr;
+    ID3D12Resource* m_pendingTexture = nullptr; // created by CreateNativeResources_AnyThread, owned by m_bufTexture after FinishSetup
+    FString m_setupError;
+    RenderStreamLink::RSPixelFormat m_format = RenderStreamLink::RS_FMT_INVALID;
+    uint64 m_gpuMemory = 0;
     int m_fenceValue = 1;
     FIntPoint m_resolution;
     RenderStreamLink::StreamHandle m_handle;
+
+    std::atomic<float> m_copyTime { 0.f };
+    std::atomic<float> m_sendTime { 0.f };
+    std::atomic<float> m_copyGPUTime { 0.f };
+    std::string m_copyTimeStatName;
+    std::string m_sendTimeStatName;
+    std::string m_copyGPUTimeStatName;
+
+    // Timestamp queries around the copy pass, oldest first, waiting for their results.
+    struct FGPUTimingQueries
+    {
+        FRHIPooledRenderQuery Begin;
+        FRHIPooledRenderQuery End;
+        uint32 FrameNumber = 0; // render thread frame the copy was issued on
+    };
+    // Results are read this many frames after the copy, by when the GPU has long finished it.
+    static constexpr uint32 GPUTimingLatency = 3;
+    static constexpr int32 MaxPendingGPUTimings = GPUTimingLatency + 1;
+    FRenderQueryPoolRHIRef m_gpuQueryPool;
+    TArray<FGPUTimingQueries> m_gpuTimingQueries;
 };
\ No newline at end of file
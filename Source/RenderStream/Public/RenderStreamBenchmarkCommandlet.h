@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "RenderStreamBenchmarkCommandlet.generated.h"
+
+/**
+ * Drives frames through the plugin's own pipeline (await, scene and camera apply, copy and send) against the fake
+ * RenderStream backend, independently of scene content, and reports frames/s, per-stage times and latencies as JSON.
+ *
+ * UE4Editor-Cmd.exe <Project> -run=RenderStreamBenchmark -AllowCommandletRendering [-Streams=4] [-Width=1920] [-Height=1080]
+ *     [-Format=BGRA8|BGRX8|RGBA32F] [-Frames=600] [-Warmup=60] [-Output=<File>] [-Baseline=<File>] [-Tolerance=0.1]
+ *
+ * Needs a D3D11 or D3D12 RHI. Returns non-zero when compared against a baseline which it regressed from by more than the tolerance.
+ */
+UCLASS()
+class URenderStreamBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URenderStreamBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -33,6 +33,23 @@ public:
     uint32 DmxType;
 };
 
+// What a level contributes to the schema. Written as asset registry tags on the level when it is saved, so caches can
+// be rebuilt without loading the level.
+USTRUCT()
+struct FRenderStreamLevelMetadata
+{
+public:
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TSet<FSoftObjectPath> SubLevels;
+    UPROPERTY()
+    TSet<FString> Channels;
+    UPROPERTY()
+    TArray<FRenderStreamExposedParameterEntry> ExposedParams;
+};
+
+// Legacy per-level cache, superseded by FRenderStreamSchemaIndex. Kept so existing cache assets load and can be deleted.
 UCLASS(ClassGroup = (RenderStream))
 class RENDERSTREAM_API URenderStreamChannelCacheAsset : public UObject
 {
@@ -4,6 +4,7 @@
 #include "Components/ActorComponent.h"
 #include "Components/SceneCaptureComponent.h"
 #include "Camera/CameraActor.h"
+#include "SceneTypes.h"
 #include "RenderStreamChannelDefinition.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogRenderStreamChannelDefinition, Log, All);
@@ -30,6 +31,12 @@ public:
     UPROPERTY(EditAnywhere, interp, Category = SceneCapture)
     TArray<struct FEngineShowFlagsSetting> ShowFlagSettings;
 
+    // Render this channel on one in every FrameRateDivisor frames, the last rendered frame is re-sent in between.
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = SceneCapture, meta = (ClampMin = "1", ClampMax = "8"))
+    int32 FrameRateDivisor;
+
+    static constexpr int32 MaxFrameRateDivisor = 8;
+
     UFUNCTION(BlueprintCallable, Category = SceneCapture)
     TArray<ACameraActor*> GetInstancedCameras();
     void AddCameraInstance(TWeakObjectPtr<ACameraActor> Camera) { InstancedCameras.Add(Camera); }
@@ -40,6 +47,9 @@ public:
     static TWeakObjectPtr<ACameraActor> GetChannelCamera(const FString& Channel);
 
     void UpdateShowFlags();
+
+    // Primitives of the actors filtered out of (or into, if hidden by default) this channel's views.
+    void GetFilteredPrimitives(TSet<FPrimitiveComponentId>& OutPrimitives) const;
 #if WITH_EDITOR
     virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
     virtual void PostEditUndo() override;
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "RenderStreamDmxSendCommandlet.generated.h"
+
+/**
+ * Sends DMX universes to a node's DMX receiver, see RenderStreamDmx.h, to test parameter ingest over loopback.
+ *
+ * UE4Editor-Cmd.exe <Project> -run=RenderStreamDmxSend [-Protocol=ArtNet|sACN] [-Host=127.0.0.1] [-Port=] [-Universe=0] [-Universes=1] [-Rate=44] [-Count=0] [-Value=-1]
+ *
+ * Port defaults to the protocol's port. Sends Rate frames per second, Count of them or until interrupted when it is 0.
+ * Every channel is set to Value, or ramps through its range when Value is negative.
+ */
+UCLASS()
+class URenderStreamDmxSendCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URenderStreamDmxSendCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -266,7 +266,10 @@ public:
 
     bool loadExplicit();
     bool unloadExplicit();
+    // Load the in-process stand-in for d3renderstream.dll instead, see RenderStreamFakeBackend.h.
+    bool loadFake();
 
+    // A schema and the arena holding everything it points to, see FRenderStreamSchemaBuilder.
     struct ScopedSchema
     {
         ScopedSchema()
@@ -279,46 +282,41 @@ public:
         }
         void reset()
         {
-            for (size_t i = 0; i < schema.channels.nChannels; ++i)
-                free(const_cast<char*>(schema.channels.channels[i]));
-            free(schema.channels.channels);
-            for (size_t i = 0; i < schema.scenes.nScenes; ++i)
-            {
-                RemoteParameters& scene = schema.scenes.scenes[i];
-                free(const_cast<char*>(scene.name));
-                for (size_t j = 0; j < scene.nParameters; ++j)
-                {
-                    RemoteParameter& parameter = scene.parameters[j];
-                    free(const_cast<char*>(parameter.group));
-                    free(const_cast<char*>(parameter.displayName));
-                    free(const_cast<char*>(parameter.key));
-                    for (size_t k = 0; k < parameter.nOptions; ++k)
-                    {
-                        free(const_cast<char*>(parameter.options[k]));
-                    }
-                    free(parameter.options);
-                }
-                free(scene.parameters);
-            }
-            free(schema.scenes.scenes);
+            free(arena);
+            arena = nullptr;
+            arenaSize = 0;
             clear();
         }
 
         ScopedSchema(const ScopedSchema&) = delete;
         ScopedSchema(ScopedSchema&& other)
+            : schema(other.schema)
+            , arena(other.arena)
+            , arenaSize(other.arenaSize)
         {
-            schema = std::move(other.schema);
-            other.reset();
+            other.arena = nullptr;
+            other.arenaSize = 0;
+            other.clear();
         }
         ScopedSchema& operator=(const ScopedSchema&) = delete;
         ScopedSchema& operator=(ScopedSchema&& other)
         {
-            schema = std::move(other.schema);
-            other.reset();
+            if (this != &other)
+            {
+                reset();
+                schema = other.schema;
+                arena = other.arena;
+                arenaSize = other.arenaSize;
+                other.arena = nullptr;
+                other.arenaSize = 0;
+                other.clear();
+            }
             return *this;
         }
 
         Schema schema;
+        void* arena = nullptr;
+        size_t arenaSize = 0;
 
     private:
         void clear()
@@ -357,6 +355,7 @@ public: // d3renderstream.h API, but loaded dynamically.
 
 private:
     bool m_loaded = false;
+    bool m_fake = false;
     void* m_dll = nullptr;
 };
 
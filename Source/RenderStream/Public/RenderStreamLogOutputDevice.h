@@ -1,37 +1,84 @@
 #pragma once
 
-#include "Engine/Console.h" 
-#include "RenderStreamLink.h"
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "Misc/OutputDevice.h"
 
-class FRenderStreamLogOutputDevice : public FOutputDevice
+#include <atomic>
+#include <string>
+
+class FRunnableThread;
+class FEvent;
+
+// Forwards the engine log to d3's console. Logging threads only filter and enqueue, a background thread
+// coalesces queued messages into batched rs_logToD3 calls, rate limited so a log storm can't flood d3.
+class FRenderStreamLogOutputDevice : public FOutputDevice, public FRunnable
 {
 public:
-    FRenderStreamLogOutputDevice()
-    {
-        check(GLog);
-        GLog->AddOutputDevice(this);
-    }
+    FRenderStreamLogOutputDevice();
+    ~FRenderStreamLogOutputDevice();
 
-    ~FRenderStreamLogOutputDevice()
-    {
-        if (GLog != nullptr)
-        {
-            GLog->RemoveOutputDevice(this);
-        }
-    }
+    // Most verbose message forwarded for categories without an override, and per category overrides.
+    void SetVerbosity(ELogVerbosity::Type DefaultVerbosity, const TMap<FName, ELogVerbosity::Type>& CategoryVerbosity);
+    // Messages forwarded per second, the rest are dropped and counted.
+    void SetRateLimit(int32 MessagesPerSecond);
+    // Messages are queued from construction and forwarded once the RenderStream library is loaded.
+    void Activate();
+
+    uint64 ForwardedMessages() const { return m_forwarded.load(std::memory_order_relaxed); }
+    // Dropped because the queue was full or because the rate limit was hit.
+    uint64 DroppedMessages() const { return m_droppedQueueFull.load(std::memory_order_relaxed) + m_droppedRateLimited.load(std::memory_order_relaxed); }
+
+    /** FOutputDevice implementation */
+    virtual bool CanBeUsedOnAnyThread() const override { return true; }
+    virtual bool CanBeUsedOnMultipleThreads() const override { return true; }
+    virtual void Flush() override;
+    virtual void TearDown() override;
 
 protected:
-    void Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const class FName& Category) override
-    {
-        if (RenderStreamLink::instance().isAvailable())
-        {
-            RenderStreamLink::instance().rs_logToD3(TCHAR_TO_ANSI(*Category.ToString()));
-            RenderStreamLink::instance().rs_logToD3(": ");
-            RenderStreamLink::instance().rs_logToD3(TCHAR_TO_ANSI(Message));
-            RenderStreamLink::instance().rs_logToD3("\n");
-        }
-    }
+    virtual void Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const class FName& Category) override;
 
 private:
+    /** FRunnable implementation */
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+    // Drains the queue into batched sends, only ever called with m_consumerLock held.
+    void Forward();
+    void SendBatch();
+
+    struct FEntry
+    {
+        FName Category;
+        ELogVerbosity::Type Verbosity;
+        FString Message;
+    };
+    TQueue<FEntry, EQueueMode::Mpsc> m_queue;
+    std::atomic<int32> m_queued { 0 };
+
+    FCriticalSection m_consumerLock;
+    std::string m_batch;
+
+    // Filtering, m_maxVerbosity is the most verbose level any category forwards and lets producers drop early.
+    FCriticalSection m_filterLock;
+    ELogVerbosity::Type m_defaultVerbosity = ELogVerbosity::Log;
+    TMap<FName, ELogVerbosity::Type> m_categoryVerbosity;
+    std::atomic<int32> m_maxVerbosity { ELogVerbosity::Log };
+
+    std::atomic<int32> m_rateLimit { 200 };
+    double m_rateWindowStart = 0;
+    int32 m_rateWindowCount = 0;
+    uint64 m_reportedDrops = 0;
+    double m_reportedDropsWindow = -1; // start of the rate window drops were last reported in
+
+    std::atomic<uint64> m_forwarded { 0 };
+    std::atomic<uint64> m_droppedQueueFull { 0 };
+    std::atomic<uint64> m_droppedRateLimited { 0 };
 
-};
\ No newline at end of file
+    FRunnableThread* m_thread = nullptr;
+    FEvent* m_wake = nullptr;
+    std::atomic<bool> m_active { false };
+    std::atomic<bool> m_stop { false };
+    bool m_tornDown = false;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "RenderStreamMicrobenchmarkCommandlet.generated.h"
+
+/**
+ * Times the plugin's CPU hot paths in isolation: sync frame data mapping and string coding, parameter validation and
+ * application, stream pool lookups, schema construction and teardown and the channel visibility set build.
+ * Runs headless against the fake RenderStream backend, no GPU is needed.
+ *
+ * UE4Editor-Cmd.exe <Project> -run=RenderStreamMicrobenchmark [-Warmup=100] [-Repetitions=50] [-Filter=<Substring>] [-Output=<File>]
+ *
+ * Each case runs its warm-up iterations, then times Repetitions batches and reports per-iteration microseconds as JSON.
+ */
+UCLASS()
+class URenderStreamMicrobenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URenderStreamMicrobenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
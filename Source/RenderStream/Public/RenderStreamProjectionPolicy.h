@@ -5,6 +5,7 @@
 #include "Render/Projection/IDisplayClusterProjectionPolicy.h"
 #include <deque>
 #include <mutex>
+#include <string>
 
 class UCameraComponent;
 class UWorld;
@@ -19,7 +20,7 @@ class FRenderStreamProjectionPolicy
     : public IDisplayClusterProjectionPolicy
 {
 public:
-    FRenderStreamProjectionPolicy(const FString& ViewportId, const TMap<FString, FString>& Parameters);
+    FRenderStreamProjectionPolicy(const FString& ViewportId, const TMap<FString, FString>& Parameters, int32 PolicyIndex);
     virtual ~FRenderStreamProjectionPolicy();
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -37,8 +38,11 @@ public:
     virtual void ApplyWarpBlend_RenderThread(const uint32 ViewIdx, FRHICommandListImmediate& RHICmdList, FRHITexture2D* SrcTexture, const FIntRect& ViewportRect) override;
 
     const FString& GetViewportId() const { return ViewportId; }
+    int32 GetPolicyIndex() const { return PolicyIndex; }
 
     const ACameraActor* GetTemplateCamera() const;
+    // The instance of the template camera this policy renders from.
+    const ACameraActor* GetCamera() const { return Camera.Get(); }
 
     const TMap<FString, FString>& GetParameters() const
     {
@@ -49,9 +53,30 @@ public:
 
     const int32_t GetPlayerControllerID() const { return PlayerControllerID; }
 
+    int32 GetFrameRateDivisor() const { return FrameRateDivisor; }
+    bool HasRenderedFrame() const { return RenderedFrame; }
+    // Called once per received frame, with whether the view is rendered this frame.
+    void UpdateFrameRate(bool Rendered);
+    float GetRealisedFrameRate() const { return RealisedFrameRate; }
+    const char* GetFrameRateStatName() const { return FrameRateStatName.c_str(); }
+
+    const TSharedPtr<FFrameStream>& GetStream() const { return Stream; }
+    // Attach the policy to its stream, done by StartScene or directly when there is no nDisplay viewport (benchmarks).
+    void BindStream(const TSharedPtr<FFrameStream>& InStream);
+    // Bind the named stream and its channel's camera, an empty name leaves the viewport without a stream.
+    // Used by StartScene and when the cluster scheduler moves streams, which flushes rendering first.
+    bool AssignStream(const FString& StreamName);
+    FIntPoint GetViewportResolution() const { return ViewportResolution; }
+    // Frame responses waiting for their render call.
+    int32 GetQueueDepth();
+    uint64 GetQueueMemory();
+    const char* GetQueueDepthStatName() const { return QueueDepthStatName.c_str(); }
+
 protected:
     const FString ViewportId;
     TMap<FString, FString> Parameters;
+    // Index into the factory's policies, matches the view family index.
+    const int32 PolicyIndex;
 
     // Near/far clip planes
     float NCP;
@@ -60,8 +85,18 @@ protected:
     TWeakObjectPtr<ACameraActor> Camera = nullptr;
     TWeakObjectPtr<ACameraActor> Template = nullptr;
     TSharedPtr<FFrameStream> Stream = nullptr;
+    FIntPoint ViewportResolution = FIntPoint::ZeroValue;
     int32_t PlayerControllerID = INDEX_NONE;
 
+    // Frame-rate divisor taken from the channel definition, and the measured rendering rate.
+    int32 FrameRateDivisor = 1;
+    bool RenderedFrame = false;
+    int32 RenderedFrames = 0;
+    double RateWindowStart = 0;
+    float RealisedFrameRate = 0.f;
+    std::string FrameRateStatName;
+    std::string QueueDepthStatName;
+
     FRenderStreamModule* Module;
 
     std::mutex m_frameResponsesLock;
@@ -6,15 +6,27 @@
 
 class UWorld;
 class AActor;
+class FRenderStreamSchemaIndex;
 
 // Select a scene within the project, provide and apply parameters.
 class RenderStreamSceneSelector
 {
 public:
     virtual ~RenderStreamSceneSelector();
-    void LoadSchemas(const UWorld& world);
+    // The loaded schema is checked against Index when there is one.
+    void LoadSchemas(const UWorld& world, const FRenderStreamSchemaIndex* Index = nullptr);
     virtual void ApplyScene(const UWorld& world, uint32_t sceneId) = 0;
 
+    // Time spent in ApplyParameters since the last call, in milliseconds.
+    double TakeParameterApplyTime();
+    // Parameter sets received from d3 and applied, since the schema was loaded.
+    uint64 ParameterUpdates() const { return m_parameterUpdates; }
+    // Null when the scene is not in the schema.
+    const char* SceneName(uint32_t sceneId) const;
+    uint32_t NumScenes() const { return Schema().scenes.nScenes; }
+    // Bytes held by the loaded schema.
+    size_t SchemaMemory() const { return m_schemaMem.capacity() + m_defaultSchema.arenaSize; }
+
 protected:
     const RenderStreamLink::Schema& Schema() const;
 
@@ -28,4 +40,6 @@ private:
 
     std::vector<uint8_t> m_schemaMem;
     RenderStreamLink::ScopedSchema m_defaultSchema;
+    mutable double m_parameterApplyTime = 0;
+    mutable uint64 m_parameterUpdates = 0;
 };
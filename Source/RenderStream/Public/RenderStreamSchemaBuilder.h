@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderStreamLink.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Builds a RenderStreamLink::Schema in a single allocation. Channels, scenes and parameters are recorded in order,
+// strings are interned as they are added, and Build lays the whole graph out in one arena: the arrays first, then
+// the de-duplicated strings. The result can be passed to rs_setSchema and rs_saveSchema as is and is freed at once.
+class RENDERSTREAM_API FRenderStreamSchemaBuilder
+{
+public:
+    void AddChannel(const char* Channel);
+
+    // Parameters and their options are added to the last scene, in the order they appear in the schema.
+    void AddScene(const char* Name);
+    void AddParameter(const char* Group, const char* DisplayName, const char* Key, float Min, float Max, float Step, float DefaultValue, int32 DmxOffset, uint32 DmxType);
+    void AddOption(const char* Option);
+
+    uint32 NumScenes() const { return uint32(m_scenes.size()); }
+
+    RenderStreamLink::ScopedSchema Build() const;
+
+private:
+    uint32 Intern(const char* String);
+
+    struct FScene
+    {
+        uint32 Name;
+        uint32 FirstParameter;
+        uint32 NumParameters;
+    };
+
+    struct FParameter
+    {
+        uint32 Group;
+        uint32 DisplayName;
+        uint32 Key;
+        float Min;
+        float Max;
+        float Step;
+        float DefaultValue;
+        uint32 FirstOption;
+        uint32 NumOptions;
+        int32 DmxOffset;
+        uint32 DmxType;
+    };
+
+    // Everything refers to strings by their offset into m_strings until Build.
+    std::vector<uint32> m_channels;
+    std::vector<FScene> m_scenes;
+    std::vector<FParameter> m_parameters;
+    std::vector<uint32> m_options;
+
+    std::string m_strings;
+    std::unordered_map<std::string, uint32> m_interned;
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SortedMap.h"
+#include "RenderStreamChannelCacheAsset.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// Project-wide index of what each level contributes to the schema: its sub-levels, channels and exposed parameters.
+// One compact file, read through a single memory mapping by the editor to build the schema and at runtime to check
+// the schema d3 loaded is up to date.
+//
+// Layout, all offsets are bytes from the start of the file and every section is 4 byte aligned:
+//   FHeader
+//   FLevel[NumLevels]          sorted by Path, byte-wise
+//   FParameter[NumParameters]  each level's parameters are contiguous
+//   uint32[NumIndices]         string offsets, for the sub-levels, channels and options ranges
+//   char[StringsSize]          null terminated UTF-8, de-duplicated
+namespace RenderStreamSchemaIndex
+{
+    static constexpr uint32 Magic = 0x58495352; // 'RSIX'
+    static constexpr uint32 Version = 1;
+
+    struct FHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint32 FileSize;
+        uint32 NumLevels;
+        uint32 LevelsOffset;
+        uint32 NumParameters;
+        uint32 ParametersOffset;
+        uint32 NumIndices;
+        uint32 IndicesOffset;
+        uint32 StringsSize;
+        uint32 StringsOffset;
+    };
+
+    // A run of string offsets in the indices section.
+    struct FStringRange
+    {
+        uint32 First;
+        uint32 Num;
+    };
+
+    struct FLevel
+    {
+        uint32 Path; // level package name
+        uint32 SourceHash; // hash of the metadata this entry was built from
+        FStringRange SubLevels;
+        FStringRange Channels;
+        uint32 FirstParameter;
+        uint32 NumParameters;
+    };
+
+    struct FParameter
+    {
+        uint32 Group;
+        uint32 DisplayName;
+        uint32 Key;
+        float Min;
+        float Max;
+        float Step;
+        float DefaultValue;
+        FStringRange Options;
+        int32 DmxOffset;
+        uint32 DmxType;
+    };
+}
+
+class RENDERSTREAM_API FRenderStreamSchemaIndex
+{
+public:
+    using FLevel = RenderStreamSchemaIndex::FLevel;
+    using FParameter = RenderStreamSchemaIndex::FParameter;
+    using FStringRange = RenderStreamSchemaIndex::FStringRange;
+
+    // The project's index, packaged builds need RenderStream added to the directories staged as non-UFS.
+    static FString DefaultPath();
+
+    // Maps and validates the whole file, nullptr when it is missing or invalid. The file can't be replaced while open.
+    static TUniquePtr<FRenderStreamSchemaIndex> Open(const FString& Path);
+    ~FRenderStreamSchemaIndex();
+
+    uint32 NumLevels() const { return Header().NumLevels; }
+    const FLevel& Level(uint32 Index) const { return Section<FLevel>(Header().LevelsOffset)[Index]; }
+    // INDEX_NONE when the level is not in the index.
+    int32 FindLevel(const FString& Path) const;
+
+    const FParameter& Parameter(const FLevel& Level, uint32 Index) const { return Section<FParameter>(Header().ParametersOffset)[Level.FirstParameter + Index]; }
+
+    // Strings stay valid as long as the index is open.
+    const char* String(uint32 Offset) const { return reinterpret_cast<const char*>(m_data + Header().StringsOffset + Offset); }
+    const char* String(const FStringRange& Range, uint32 Index) const { return String(Section<uint32>(Header().IndicesOffset)[Range.First + Index]); }
+
+private:
+    FRenderStreamSchemaIndex() = default;
+    bool Validate() const;
+
+    const RenderStreamSchemaIndex::FHeader& Header() const { return *reinterpret_cast<const RenderStreamSchemaIndex::FHeader*>(m_data); }
+    template <typename T>
+    const T* Section(uint32 Offset) const { return reinterpret_cast<const T*>(m_data + Offset); }
+
+    TUniquePtr<IMappedFileHandle> m_file;
+    TUniquePtr<IMappedFileRegion> m_region;
+    const uint8* m_data = nullptr;
+    int64 m_size = 0;
+};
+
+// Builds index files. Levels are replaced one at a time, every other level is carried over from the existing index.
+class RENDERSTREAM_API FRenderStreamSchemaIndexWriter
+{
+public:
+    explicit FRenderStreamSchemaIndexWriter(const FRenderStreamSchemaIndex* Existing = nullptr);
+
+    void SetLevel(const FString& Path, const FRenderStreamLevelMetadata& Metadata, const FString& SourceHash);
+    void RemoveLevel(const FString& Path);
+    TArray<FString> LevelPaths() const;
+
+    // Written to a temporary file and moved over Path, readers never see a partial index.
+    bool Save(const FString& Path) const;
+
+private:
+    struct FEntry
+    {
+        FRenderStreamLevelMetadata Metadata;
+        FString SourceHash;
+    };
+    TSortedMap<FString, FEntry> m_levels;
+};
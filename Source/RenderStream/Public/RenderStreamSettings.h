@@ -22,7 +22,26 @@ enum class ERenderStreamSceneSelector
 
     // RenderStream will load maps, without changing any sub-level visibility settings.
     Maps                UMETA(DisplayName = "Maps"),
+
+    // RenderStream will manage streaming level visibility and loading, keeping levels loaded once shown so switching
+    // back does not load, up to ResidentSceneMemoryBudget.
+    ResidentLevels      UMETA(DisplayName = "Resident streaming levels"),
+};
+
+// Mirrors ELogVerbosity, which is not exposed to reflection.
+UENUM()
+enum class ERenderStreamLogVerbosity : uint8
+{
+    NoLogging = 0       UMETA(DisplayName = "No logging"),
+    Fatal               UMETA(DisplayName = "Fatal"),
+    Error               UMETA(DisplayName = "Error"),
+    Warning             UMETA(DisplayName = "Warning"),
+    Display             UMETA(DisplayName = "Display"),
+    Log                 UMETA(DisplayName = "Log"),
+    Verbose             UMETA(DisplayName = "Verbose"),
+    VeryVerbose         UMETA(DisplayName = "Very verbose"),
 };
+
 /**
 * Implements the settings for the RenderStream plugin.
 */
@@ -34,4 +53,65 @@ class RENDERSTREAM_API URenderStreamSettings : public UObject
 public:
     UPROPERTY(EditAnywhere, config, Category = Settings)
     ERenderStreamSceneSelector SceneSelector;
+
+    // Megabytes of physical memory the process may use before the resident levels scene selector unloads the least
+    // recently shown levels, 0 keeps every level loaded.
+    UPROPERTY(EditAnywhere, config, Category = Settings, meta = (ClampMin = "0"))
+    int32 ResidentSceneMemoryBudget;
+
+    // Most verbose log messages forwarded to d3's console.
+    UPROPERTY(EditAnywhere, config, Category = Logging)
+    ERenderStreamLogVerbosity LogForwardingVerbosity;
+
+    // Per log category overrides of LogForwardingVerbosity, e.g. to silence a noisy category.
+    UPROPERTY(EditAnywhere, config, Category = Logging)
+    TMap<FName, ERenderStreamLogVerbosity> LogForwardingCategoryVerbosity;
+
+    // Log messages forwarded to d3 per second, the rest are dropped and counted in the profiling data.
+    UPROPERTY(EditAnywhere, config, Category = Logging, meta = (ClampMin = "1"))
+    int32 LogForwardingRateLimit;
+
+    // Seconds awaiting or receiving frame data may take before it is reported as a stall, 0 disables the check.
+    UPROPERTY(EditAnywhere, config, Category = Watchdog, meta = (ClampMin = "0"))
+    float SyncStallThreshold;
+
+    // Seconds sending a stream's frame may block the rendering thread before it is reported as a stall, 0 disables the check.
+    UPROPERTY(EditAnywhere, config, Category = Watchdog, meta = (ClampMin = "0"))
+    float SendStallThreshold;
+
+    // Seconds a game thread frame may take before it is reported as a stall, 0 disables the check. Map loads count.
+    UPROPERTY(EditAnywhere, config, Category = Watchdog, meta = (ClampMin = "0"))
+    float GameThreadStallThreshold;
+
+    // Recreate a stream's texture and fence once a send which stalled returns.
+    UPROPERTY(EditAnywhere, config, Category = Watchdog)
+    bool bRecreateStalledStreams;
+
+    // Let the controller move streams between nDisplay nodes by their measured cost. A stream can move to any
+    // renderstream viewport of its resolution, otherwise each viewport renders the stream with its name.
+    UPROPERTY(EditAnywhere, config, Category = Cluster)
+    bool bBalanceStreams;
+
+    // Seconds between the controller's attempts to balance streams.
+    UPROPERTY(EditAnywhere, config, Category = Cluster, meta = (ClampMin = "1", EditCondition = "bBalanceStreams"))
+    float StreamBalanceInterval;
+
+    // Fraction by which a new assignment has to lower the busiest node's predicted load to be used.
+    UPROPERTY(EditAnywhere, config, Category = Cluster, meta = (ClampMin = "0", ClampMax = "1", EditCondition = "bBalanceStreams"))
+    float StreamBalanceThreshold;
+
+    // UDP port on which DMX universes are received as a parameter source alongside d3, 0 disables it. Art-Net (6454)
+    // and sACN (5568) packets are both accepted, multicast sACN on 5568 only. Only parameters whose property sets
+    // RenderStreamDmxOffset metadata are driven by DMX, and follow whichever of d3 and DMX changed them last. In a
+    // cluster only the controller receives, the console needs to reach that node.
+    UPROPERTY(EditAnywhere, config, Category = DMX, meta = (ClampMin = "0", ClampMax = "65535"))
+    int32 DmxPort;
+
+    // Universe at which the parameters' DMX offsets start, numbered as the sending protocol numbers it.
+    UPROPERTY(EditAnywhere, config, Category = DMX, meta = (ClampMin = "0", ClampMax = "63999"))
+    int32 DmxFirstUniverse;
+
+    // Consecutive universes received from DmxFirstUniverse.
+    UPROPERTY(EditAnywhere, config, Category = DMX, meta = (ClampMin = "1", ClampMax = "64"))
+    int32 DmxUniverses;
 };
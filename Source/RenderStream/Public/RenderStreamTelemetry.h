@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+
+#include <atomic>
+
+// Fixed layout telemetry a node publishes once per frame in named shared memory, so monitoring outside the process can
+// see inside it without going through d3 or costing the game or render thread anything more than a copy.
+// The layout only ever grows at the end, and Version changes whenever a field changes meaning.
+struct FRenderStreamTelemetryPage
+{
+    static constexpr uint32 PageMagic = 0x4D545352; // "RSTM"
+    static constexpr uint32 PageVersion = 1;
+    static constexpr int32 MaxStreams = 16;
+    static constexpr int32 MaxName = 64;
+    static constexpr int32 MaxStatus = 256;
+
+    struct FStream
+    {
+        char Name[MaxName];  // UTF-8, null terminated
+        uint64 FramesSent;   // frames d3 requested which were sent, rendered or resent
+        uint64 FramesDropped; // frames d3 requested which resent the previous frame instead
+        float LatencyMs;     // from the frame response to its send: frames queued for their render call, then copy and send
+        float FrameRate;     // realised frame rate
+        float CopyTime;
+        float SendTime;
+        float CopyGPUTime;
+        uint32 QueueDepth;
+    };
+
+    struct FData
+    {
+        uint64 FrameNumber;
+        double Timestamp;     // FPlatformTime::Seconds() of the publishing process
+        double TrackedTime;   // d3 tracked time of the applied frame, in seconds
+        float FrameTime;
+        float AwaitTime;
+        float ReceiveTime;
+        float ParameterUpdateRate; // parameter sets applied per second
+        float ParameterApplyTime;
+        uint32 Scene;
+        char SceneName[MaxName];
+        char Status[MaxStatus]; // d3's status message, empty when the node renders normally
+        uint32 NumStreams;
+        FStream Streams[MaxStreams]; // indexed by projection policy
+    };
+
+    // Written once when the page is created.
+    uint32 Magic;
+    uint32 Version;
+    uint32 Size;
+    // Seqlock over Data: odd while it is being written, readers retry until they see the same even value either side.
+    std::atomic<uint32> Sequence;
+    FData Data;
+};
+
+// Publishes the page, with a single writer on the game thread. Writes never block and never wait for readers.
+class FRenderStreamTelemetry
+{
+public:
+    ~FRenderStreamTelemetry();
+
+    // Creates the named region and clears it, so it must only be called by the process the page belongs to.
+    bool Open(const FString& Name = DefaultName());
+    void Close();
+    bool IsOpen() const { return m_page != nullptr; }
+
+    // Returns the data to update in place, counters keep their values from the previous frame.
+    FRenderStreamTelemetryPage::FData& BeginWrite();
+    void EndWrite();
+
+    // Read-only access to a page published by another process, see the RenderStreamTelemetry commandlet.
+    class FReader
+    {
+    public:
+        ~FReader();
+
+        // Maps an existing page, never creating or clearing it.
+        bool Open(const FString& Name);
+        // Copies a consistent snapshot, false if there is none yet or the writer kept overtaking the copy.
+        bool Read(FRenderStreamTelemetryPage::FData& Out) const;
+
+    private:
+        FPlatformMemory::FSharedMemoryRegion* m_region = nullptr;
+        const FRenderStreamTelemetryPage* m_page = nullptr;
+    };
+
+    // This process's page, one per node so instances on one host never share a writer: the nDisplay node id when
+    // there is one and the process id otherwise. Overridden with -RenderStreamTelemetry=<Name>.
+    static FString DefaultName();
+    static FString PageName(const FString& Instance);
+
+private:
+    FPlatformMemory::FSharedMemoryRegion* m_region = nullptr;
+    FRenderStreamTelemetryPage* m_page = nullptr;
+};
+
+// Copies Text into a fixed size field, truncated and null terminated.
+template <int32 N>
+void RenderStreamTelemetryCopy(char (&Field)[N], const char* Text)
+{
+    FCStringAnsi::Strncpy(Field, Text ? Text : "", N);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "RenderStreamTelemetryCommandlet.generated.h"
+
+/**
+ * Prints the telemetry page a running node publishes, see RenderStreamTelemetry.h. Reading never blocks the node.
+ *
+ * UE4Editor-Cmd.exe <Project> -run=RenderStreamTelemetry -Node=<Id>|-Name=<Page> [-Interval=500] [-Count=0]
+ *
+ * Node is the nDisplay node id, or the process id of a node outside a cluster. Name is the full page name of a node
+ * started with -RenderStreamTelemetry=<Page>. Prints every Interval milliseconds, Count times or until interrupted
+ * when it is 0.
+ */
+UCLASS()
+class URenderStreamTelemetryCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URenderStreamTelemetryCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -9,9 +9,26 @@ class FFrameStream;
 class FStreamPool
 {
 public:
+    struct FStreamDescription
+    {
+        FString Name;
+        FIntPoint Resolution;
+        FString Channel;
+        RenderStreamLink::ProjectionClipping Clipping;
+        RenderStreamLink::StreamHandle Handle;
+        RenderStreamLink::RSPixelFormat Format;
+    };
+
+    // add streams to the pool for anything to get, their GPU resources are created in parallel
+    // streams which fail are logged with the reason and left out, returns how many were added
+    int32 AddNewStreamsToPool(const TArray<FStreamDescription>& Descriptions);
+
     // add a stream to the pool for anything to get
     bool AddNewStreamToPool(const FString& StreamName, const FIntPoint& Resolution, const FString& Channel, const RenderStreamLink::ProjectionClipping& Clipping, RenderStreamLink::StreamHandle Handle, RenderStreamLink::RSPixelFormat Fmt);
 
+    // add a stream which has already been set up
+    void AddStreamToPool(const TSharedPtr<FFrameStream>& Stream);
+
     // get the stream by name
     TSharedPtr<FFrameStream> GetStream(const FString& desiredStreamName);
 
@@ -25,6 +42,9 @@ public:
     // get the allocated streams which are all considered "active"
     const TMap<uint32, TSharedPtr<FFrameStream>>& GetActiveStreams() const;
 
+    // every stream, pooled or allocated
+    TArray<TSharedPtr<FFrameStream>> GetAllStreams() const;
+
     uint32_t PoolCount() const;
     uint32_t StreamCount() const;
 
@@ -17,11 +17,17 @@
 
 #include "ISettingsModule.h"
 #include "RenderStreamChannelCacheAsset.h"
+#include "RenderStreamSchemaBuilder.h"
+#include "RenderStreamSchemaIndex.h"
+#include "RenderStreamSchemaGeneration.h"
 #include "RenderStreamChannelDefinition.h"
 #include "RenderStreamCustomization.h"
 #include "RenderStreamSettings.h"
 #include "AssetRegistry/AssetRegistryModule.h"
-#include "Engine/ObjectLibrary.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/SecureHash.h"
+#include "Async/ParallelFor.h"
 
 #include "RenderStream/Public/RenderStreamLink.h"
 #include <set>
@@ -34,8 +40,13 @@ DEFINE_LOG_CATEGORY(LogRenderStreamEditor);
 
 #define LOCTEXT_NAMESPACE "RenderStreamEditor"
 
+// Where channel cache assets used to be saved, they are deleted once the schema index is built.
 const FString CacheFolder = TEXT("/disguiseuerenderstream/Cache");
 
+// Asset registry tags written on levels when they are saved, see OnGetWorldAssetTags.
+static const FName LevelMetadataTag(TEXT("RenderStreamMetadata"));
+static const FName LevelMetadataHashTag(TEXT("RenderStreamMetadataHash"));
+
 void FRenderStreamEditorModule::StartupModule()
 {
     {
@@ -63,6 +74,7 @@ void FRenderStreamEditorModule::StartupModule()
     FEditorDelegates::OnAssetsDeleted.AddRaw(this, &FRenderStreamEditorModule::OnAssetsDeleted);
     FCoreDelegates::OnBeginFrame.AddRaw(this, &FRenderStreamEditorModule::OnBeginFrame);
     FCoreDelegates::OnPostEngineInit.AddRaw(this, &FRenderStreamEditorModule::OnPostEngineInit);
+    FWorldDelegates::GetAssetTags.AddRaw(this, &FRenderStreamEditorModule::OnGetWorldAssetTags);
 }
 
 void FRenderStreamEditorModule::ShutdownModule()
@@ -77,6 +89,7 @@ void FRenderStreamEditorModule::ShutdownModule()
     FEditorDelegates::OnAssetsDeleted.RemoveAll(this);
     FCoreDelegates::OnBeginFrame.RemoveAll(this);
     FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+    FWorldDelegates::GetAssetTags.RemoveAll(this);
     if (GEditor)
         GEditor->OnBlueprintCompiled().RemoveAll(this);
 
@@ -93,14 +106,10 @@ void FRenderStreamEditorModule::DeleteCaches(const TArray<FAssetData>& InCachesT
     TArray<UObject*> Objects;
     for (const FAssetData& Cache : InCachesToDelete)
     {
-        UPackage* Package = Cast<UPackage>(Cache.GetAsset());
-        if (Package)
+        UObject* Asset = Cache.GetAsset();
+        if (Asset)
         {
-            UObject* Asset = Package->FindAssetInPackage();
-            if (Asset)
-            {
-                Objects.Push(Package->FindAssetInPackage());
-            }
+            Objects.Push(Asset);
         }
     }
 
@@ -128,31 +137,45 @@ void CreateField(FRenderStreamExposedParameterEntry& parameter, FString group, F
     parameter.Step = step;
     parameter.DefaultValue = defaultValue;
     parameter.Options = options;
-    parameter.DmxOffset = -1; // Auto
+    parameter.DmxOffset = -1; // Auto, and not driven by the DMX receiver, see AssignDmxChannels
     parameter.DmxType = 2; // Dmx16BigEndian
 }
 
-static void ConvertFields(RenderStreamLink::RemoteParameter* outputIterator, const TArray<FRenderStreamExposedParameterEntry>& input)
+// The DMX receiver only drives properties which opt in with their first channel, counted from the first received
+// universe, as meta=(RenderStreamDmxOffset="12") with an optional RenderStreamDmxType (0 8-bit, 1 16-bit little endian,
+// 2 16-bit big endian). A property's fields, such as a vector's components, take consecutive channels.
+static void AssignDmxChannels(TArray<FRenderStreamExposedParameterEntry>& Parameters, int32 FirstField, const FProperty* Property)
 {
-    for (const FRenderStreamExposedParameterEntry& entry : input)
-    {
-        RenderStreamLink::RemoteParameter& parameter = *outputIterator++;
-
-        parameter.group = _strdup(TCHAR_TO_UTF8(*entry.Group));
-        parameter.displayName = _strdup(TCHAR_TO_UTF8(*entry.DisplayName));
-        parameter.key = _strdup(TCHAR_TO_UTF8(*entry.Key));
-        parameter.min = entry.Min;
-        parameter.max = entry.Max;
-        parameter.step = entry.Step;
-        parameter.defaultValue = entry.DefaultValue;
-        parameter.nOptions = uint32_t(entry.Options.Num());
-        parameter.options = static_cast<const char**>(malloc(parameter.nOptions * sizeof(const char*)));
-        for (size_t j = 0; j < parameter.nOptions; ++j)
-        {
-            parameter.options[j] = _strdup(TCHAR_TO_UTF8(*entry.Options[j]));
-        }
-        parameter.dmxOffset = -1; // Auto
-        parameter.dmxType = 2; // Dmx16BigEndian
+    static const FName DmxOffsetMeta(TEXT("RenderStreamDmxOffset"));
+    static const FName DmxTypeMeta(TEXT("RenderStreamDmxType"));
+    if (!Property->HasMetaData(DmxOffsetMeta))
+        return;
+
+    int32 Channel = FCString::Atoi(*Property->GetMetaData(DmxOffsetMeta));
+    const uint32 Type = Property->HasMetaData(DmxTypeMeta) ? uint32(FCString::Atoi(*Property->GetMetaData(DmxTypeMeta))) : 2;
+    if (Channel < 0 || Type > 2)
+    {
+        UE_LOG(LogRenderStreamEditor, Warning, TEXT("Ignoring the invalid DMX channel %d or type %u of property %s"), Channel, Type, *Property->GetName());
+        return;
+    }
+
+    for (int32 i = FirstField; i < Parameters.Num(); ++i)
+    {
+        Parameters[i].DmxOffset = Channel;
+        Parameters[i].DmxType = Type;
+        Channel += Type == 0 ? 1 : 2;
+    }
+}
+
+static void ConvertFields(FRenderStreamSchemaBuilder& Builder, const FRenderStreamSchemaIndex& Index, const FRenderStreamSchemaIndex::FLevel& Level)
+{
+    for (uint32 i = 0; i < Level.NumParameters; ++i)
+    {
+        const FRenderStreamSchemaIndex::FParameter& entry = Index.Parameter(Level, i);
+        Builder.AddParameter(Index.String(entry.Group), Index.String(entry.DisplayName), Index.String(entry.Key),
+            entry.Min, entry.Max, entry.Step, entry.DefaultValue, entry.DmxOffset, entry.DmxType);
+        for (uint32 j = 0; j < entry.Options.Num; ++j)
+            Builder.AddOption(Index.String(entry.Options, j));
     }
 }
 
@@ -172,7 +195,8 @@ TArray<FString> EnumOptions(const FNumericProperty* NumericProperty)
     return Options;
 }
 
-void GenerateParameters(TArray<FRenderStreamExposedParameterEntry>& Parameters, const AActor* Root)
+// The level script actor's exposed properties, extracted into a level's metadata.
+static void GenerateParameters(TArray<FRenderStreamExposedParameterEntry>& Parameters, const AActor* Root)
 {
     if (!Root)
         return;
@@ -181,6 +205,7 @@ void GenerateParameters(TArray<FRenderStreamExposedParameterEntry>& Parameters,
         const FProperty* Property = *PropIt;
         const FString Name = Property->GetName();
         const FString Category = Property->GetMetaData("Category");
+        const int32 FirstField = Parameters.Num();
         if (!Property->HasAllPropertyFlags(CPF_Edit | CPF_BlueprintVisible) || Property->HasAllPropertyFlags(CPF_DisableEditOnInstance))
         {
             UE_LOG(LogRenderStreamEditor, Verbose, TEXT("Unexposed property: %s"), *Name);
@@ -261,274 +286,423 @@ void GenerateParameters(TArray<FRenderStreamExposedParameterEntry>& Parameters,
         {
             UE_LOG(LogRenderStreamEditor, Log, TEXT("Unsupported exposed property: %s"), *Name);
         }
+        AssignDmxChannels(Parameters, FirstField, Property);
     }
 }
 
-void GenerateScene(RenderStreamLink::RemoteParameters& SceneParameters, const URenderStreamChannelCacheAsset* cache, const URenderStreamChannelCacheAsset* persistent)
+FRenderStreamLevelMetadata ExtractLevelMetadata(const ULevel* Level)
 {
-    FString sceneName = FPackageName::GetShortName(cache->Level.GetAssetPathName());
-    SceneParameters.name = _strdup(TCHAR_TO_UTF8(*sceneName));
+    FRenderStreamLevelMetadata Metadata;
+    for (auto Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            const URenderStreamChannelDefinition* Definition = Actor->FindComponentByClass<URenderStreamChannelDefinition>();
+            if (Definition)
+            {
+                Metadata.Channels.Emplace(Actor->GetName());
+            }
+        }
+    }
 
-    const uint32_t nParams = (persistent ? persistent->ExposedParams.Num() : 0) + cache->ExposedParams.Num();
-    SceneParameters.nParameters = nParams;
-    SceneParameters.parameters = static_cast<RenderStreamLink::RemoteParameter*>(malloc(nParams * sizeof(RenderStreamLink::RemoteParameter)));
+    GenerateParameters(Metadata.ExposedParams, Level->GetLevelScriptActor());
 
-    size_t offset = 0;
-    if (persistent)
+    // The level's own world, rather than the one it is loaded into, when it is a streaming level.
+    const UWorld* World = Level->GetTypedOuter<UWorld>();
+    if (World)
     {
-        ConvertFields(SceneParameters.parameters, persistent->ExposedParams);
-        offset += persistent->ExposedParams.Num();
+        for (const ULevelStreaming* SubLevel : World->GetStreamingLevels())
+            Metadata.SubLevels.Add(FSoftObjectPath(SubLevel->GetWorldAssetPackageName()));
     }
-    ConvertFields(SceneParameters.parameters + offset, cache->ExposedParams);
 
-    UE_LOG(LogRenderStreamEditor, Log, TEXT("Generated schema for scene: %s"), UTF8_TO_TCHAR(SceneParameters.name));
+    return Metadata;
+}
+
+FString ExportLevelMetadata(const FRenderStreamLevelMetadata& Metadata)
+{
+    FString Text;
+    FRenderStreamLevelMetadata::StaticStruct()->ExportText(Text, &Metadata, nullptr, nullptr, PPF_None, nullptr);
+    return Text;
 }
 
-bool TryGetCache(const FString LevelPath, URenderStreamChannelCacheAsset*& Cache)
+bool ImportLevelMetadata(const FString& Text, FRenderStreamLevelMetadata& Metadata)
 {
-    const FString PathName = CacheFolder + LevelPath;
-    const FSoftObjectPath Path(PathName);
-    Cache = Cast<URenderStreamChannelCacheAsset>(Path.TryLoad());
-    return Cache != nullptr;
+    return FRenderStreamLevelMetadata::StaticStruct()->ImportText(*Text, &Metadata, nullptr, PPF_None, GWarn, FRenderStreamLevelMetadata::StaticStruct()->GetName()) != nullptr;
 }
 
-URenderStreamChannelCacheAsset* GetOrCreateCache(ULevel* Level)
+FString LevelMetadataHash(const FString& ExportedMetadata)
 {
-    URenderStreamChannelCacheAsset* Cache = nullptr;
-    const FString LevelPath = Level->GetPackage()->GetPathName();
-    if (!TryGetCache(LevelPath, Cache)) // Asset doesn't exists.
+    return FMD5::HashAnsiString(*ExportedMetadata);
+}
+
+static void GenerateScene(FRenderStreamSchemaBuilder& Builder, const FRenderStreamSchemaIndex& Index, const FSceneLevels& Scene)
+{
+    const FRenderStreamSchemaIndex::FLevel& Level = Index.Level(Scene.Level);
+
+    const FString sceneName = FPackageName::GetShortName(UTF8_TO_TCHAR(Index.String(Level.Path)));
+    Builder.AddScene(TCHAR_TO_UTF8(*sceneName));
+    if (Scene.Persistent != INDEX_NONE)
+        ConvertFields(Builder, Index, Index.Level(Scene.Persistent));
+    ConvertFields(Builder, Index, Level);
+
+    UE_LOG(LogRenderStreamEditor, Log, TEXT("Generated schema for scene: %s"), *sceneName);
+}
+
+bool UpdateSchemaIndex(bool bRebuild, TArray<FRenderStreamLevelTiming>* OutTimings)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    // Levels loaded in the editor report their current metadata, the rest report what they were saved with.
+    FARFilter Filter;
+    Filter.ClassNames.Add(UWorld::StaticClass()->GetFName());
+    Filter.PackagePaths.Add(TEXT("/Game"));
+    Filter.bRecursivePaths = true;
+    TArray<FAssetData> LevelAssets;
+    AssetRegistry.GetAssets(Filter, LevelAssets);
+
+    // The hash each level's entry was built from, the index is closed again before it is replaced. A rebuild starts
+    // from an empty index and loads every level, so neither the index nor the levels' tags are trusted.
+    TMap<FString, FString> IndexedHashes;
+    TUniquePtr<FRenderStreamSchemaIndex> Index = bRebuild ? nullptr : FRenderStreamSchemaIndex::Open(FRenderStreamSchemaIndex::DefaultPath());
+    FRenderStreamSchemaIndexWriter Writer(Index.Get());
+    if (Index)
     {
-        const FString PathName = CacheFolder + LevelPath;
-        FString AssetName;
-        if (!PathName.Split(TEXT("/"), nullptr, &AssetName, ESearchCase::CaseSensitive, ESearchDir::FromEnd))
+        for (uint32 i = 0; i < Index->NumLevels(); ++i)
         {
-            AssetName = PathName;
+            const FRenderStreamSchemaIndex::FLevel& Level = Index->Level(i);
+            IndexedHashes.Add(UTF8_TO_TCHAR(Index->String(Level.Path)), UTF8_TO_TCHAR(Index->String(Level.SourceHash)));
         }
+        Index.Reset();
+    }
 
-        UPackage* Package = FindPackage(nullptr, *PathName);
-        if (!Package)
+    // Each stale entry is extracted either from its level's tags or from the loaded level.
+    struct FLevelJob
+    {
+        FString LevelPath;
+        FString TaggedMetadata;
+        FString Hash;
+        const ULevel* Level = nullptr;
+        double LoadTime = 0;
+
+        FRenderStreamLevelMetadata Metadata;
+        double ExtractTime = 0;
+        bool bExtracted = false;
+    };
+    TArray<FLevelJob> Jobs;
+    TArray<const FAssetData*> UntaggedLevels;
+    TSet<FString> LevelPaths;
+    for (const FAssetData& LevelAsset : LevelAssets)
+    {
+        const FString LevelPath = LevelAsset.PackageName.ToString();
+        const FString* IndexedHash = IndexedHashes.Find(LevelPath);
+        LevelPaths.Add(LevelPath);
+
+        FString Metadata, Hash;
+        if (bRebuild)
+        {
+            UntaggedLevels.Add(&LevelAsset);
+        }
+        else if (LevelAsset.GetTagValue(LevelMetadataTag, Metadata) && LevelAsset.GetTagValue(LevelMetadataHashTag, Hash))
+        {
+            if (!IndexedHash || *IndexedHash != Hash)
+                Jobs.Add({ LevelPath, MoveTemp(Metadata), MoveTemp(Hash) });
+        }
+        else if (!IndexedHash)
         {
-            Package = CreatePackage(*PathName);
+            UntaggedLevels.Add(&LevelAsset);
         }
+    }
 
-        Package->FullyLoad();
-        Cache = NewObject<URenderStreamChannelCacheAsset>(Package, FName(AssetName), RF_Public | RF_Standalone);
+    // Levels which no longer exist.
+    int32 NumRemoved = 0;
+    for (const auto& Indexed : IndexedHashes)
+    {
+        if (!LevelPaths.Contains(Indexed.Key))
+        {
+            Writer.RemoveLevel(Indexed.Key);
+            ++NumRemoved;
+        }
     }
 
-    return Cache;
-}
+    if (Jobs.Num() == 0 && UntaggedLevels.Num() == 0)
+        return (NumRemoved == 0 && !bRebuild) || Writer.Save(FRenderStreamSchemaIndex::DefaultPath());
 
-URenderStreamChannelCacheAsset* UpdateLevelChannelCache(ULevel* Level)
-{
-    URenderStreamChannelCacheAsset* Cache = GetOrCreateCache(Level);
+    // Loading counts one unit per level, extraction one per level in total.
+    FScopedSlowTask SlowTask(float(UntaggedLevels.Num() * 2 + Jobs.Num() + 1), LOCTEXT("UpdatingSchemaIndex", "Updating RenderStream schema index..."));
+    SlowTask.MakeDialogDelayed(0.5f, true);
 
-    // Update the Cache.
-    const FString LevelPath = Level->GetPackage()->GetPathName();
-    Cache->Level = LevelPath;
-    Cache->Channels.Empty();
-    for (auto Actor : Level->Actors)
+    for (const FAssetData* LevelAsset : UntaggedLevels)
     {
-        if (Actor)
+        if (SlowTask.ShouldCancel())
+            return false;
+
+        // Saved before levels were tagged, this and a rebuild are the only cases which still load the level.
+        const FString LevelPath = LevelAsset->PackageName.ToString();
+        SlowTask.EnterProgressFrame(1.f, FText::Format(LOCTEXT("LoadingUntaggedLevel", "Loading {0}"), FText::FromString(LevelPath)));
+        if (!bRebuild)
+            UE_LOG(LogRenderStreamEditor, Log, TEXT("Loading %s to index it, resave it to avoid this"), *LevelPath);
+        const double LoadStartTime = FPlatformTime::Seconds();
+        const UWorld* World = Cast<UWorld>(LevelAsset->GetAsset());
+        const double LoadTime = FPlatformTime::Seconds() - LoadStartTime;
+        if (World && World->PersistentLevel)
         {
-            const URenderStreamChannelDefinition* Definition = Actor->FindComponentByClass<URenderStreamChannelDefinition>();
-            if (Definition)
-            {
-                Cache->Channels.Emplace(TCHAR_TO_UTF8(*Actor->GetName()));
-            }
+            FLevelJob& Job = Jobs.AddDefaulted_GetRef();
+            Job.LevelPath = LevelPath;
+            Job.Level = World->PersistentLevel;
+            Job.LoadTime = LoadTime;
+        }
+        else if (OutTimings)
+        {
+            OutTimings->Add({ LevelPath, LoadTime, 0.0, false });
+        }
+    }
+
+    // Extraction only reads already loaded data, one task per level.
+    const double ExtractStartTime = FPlatformTime::Seconds();
+    SlowTask.EnterProgressFrame(float(Jobs.Num()), LOCTEXT("ExtractingLevelMetadata", "Extracting channels and parameters..."));
+    ParallelFor(Jobs.Num(), [&Jobs](int32 JobIndex)
+    {
+        FLevelJob& Job = Jobs[JobIndex];
+        const double JobStartTime = FPlatformTime::Seconds();
+        if (Job.Level)
+        {
+            Job.Metadata = ExtractLevelMetadata(Job.Level);
+            Job.Hash = LevelMetadataHash(ExportLevelMetadata(Job.Metadata));
+            Job.bExtracted = true;
+        }
+        else
+        {
+            Job.bExtracted = ImportLevelMetadata(Job.TaggedMetadata, Job.Metadata);
+        }
+        Job.ExtractTime = FPlatformTime::Seconds() - JobStartTime;
+    });
+    const double ExtractTime = FPlatformTime::Seconds() - ExtractStartTime;
+
+    if (SlowTask.ShouldCancel())
+        return false;
+
+    // Merge into the index and write it once.
+    int32 NumUpdated = 0;
+    for (const FLevelJob& Job : Jobs)
+    {
+        if (OutTimings)
+            OutTimings->Add({ Job.LevelPath, Job.LoadTime, Job.ExtractTime, Job.bExtracted });
+
+        if (Job.bExtracted)
+        {
+            Writer.SetLevel(Job.LevelPath, Job.Metadata, Job.Hash);
+            ++NumUpdated;
+        }
+        else
+        {
+            UE_LOG(LogRenderStreamEditor, Warning, TEXT("Unable to read RenderStream metadata of %s"), *Job.LevelPath);
         }
     }
 
-    Cache->ExposedParams.Empty();
-    GenerateParameters(Cache->ExposedParams, Level->GetLevelScriptActor());
-
-    Cache->SubLevels.Empty();
-    for (ULevelStreaming* SubLevel : Level->GetWorld()->GetStreamingLevels())
-        Cache->SubLevels.Add(SubLevel->GetWorldAsset()->GetPackage()->GetPathName());
-
-    // Save the Cache.
-    UPackage* Package = Cache->GetPackage();
-    Package->MarkPackageDirty();
-    FAssetRegistryModule::AssetCreated(Cache);
-    const FString PackageFileName = FPackageName::LongPackageNameToFilename(CacheFolder + LevelPath, FPackageName::GetAssetPackageExtension());
-    bool bSaved = UPackage::SavePackage(
-        Package,
-        Cache,
-        EObjectFlags::RF_Public | EObjectFlags::RF_Standalone,
-        *PackageFileName,
-        GError,
-        nullptr,
-        true,
-        true,
-        SAVE_NoError
-    );
-
-    return Cache;
+    SlowTask.EnterProgressFrame(1.f, LOCTEXT("SavingSchemaIndex", "Saving schema index..."));
+    const double SaveStartTime = FPlatformTime::Seconds();
+    const bool bSaved = Writer.Save(FRenderStreamSchemaIndex::DefaultPath());
+    const double SaveTime = FPlatformTime::Seconds() - SaveStartTime;
+
+    UE_LOG(LogRenderStreamEditor, Log, TEXT("Updated %d and removed %d of %d levels in the schema index in %.1f ms (extraction %.1f ms, saving %.1f ms)"),
+        NumUpdated, NumRemoved, LevelAssets.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0, ExtractTime * 1000.0, SaveTime * 1000.0);
+    return bSaved;
 }
 
-void UpdateChannelCache()
+FString HashSchema(const FRenderStreamSchemaIndex& Index, const FRenderStreamSchemaPlan& Plan)
 {
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    for (ULevel* Level : World->GetLevels())
+    FSHA1 Hash;
+    auto HashString = [&Hash](const char* String)
     {
-        if (Level)
-            UpdateLevelChannelCache(Level);
-    }
+        Hash.Update(reinterpret_cast<const uint8*>(String), uint32(FCStringAnsi::Strlen(String) + 1)); // including the terminator, so adjacent strings can't run together
+    };
+    auto HashValue = [&Hash](const auto& Value)
+    {
+        Hash.Update(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+    };
+    auto HashParameters = [&](const FRenderStreamSchemaIndex::FLevel* Level)
+    {
+        const uint32 NumParameters = Level ? Level->NumParameters : 0;
+        HashValue(NumParameters);
+        for (uint32 i = 0; i < NumParameters; ++i)
+        {
+            const FRenderStreamSchemaIndex::FParameter& Parameter = Index.Parameter(*Level, i);
+            HashString(Index.String(Parameter.Group));
+            HashString(Index.String(Parameter.DisplayName));
+            HashString(Index.String(Parameter.Key));
+            HashValue(Parameter.Min);
+            HashValue(Parameter.Max);
+            HashValue(Parameter.Step);
+            HashValue(Parameter.DefaultValue);
+            HashValue(Parameter.DmxOffset);
+            HashValue(Parameter.DmxType);
+            HashValue(Parameter.Options.Num);
+            for (uint32 j = 0; j < Parameter.Options.Num; ++j)
+                HashString(Index.String(Parameter.Options, j));
+        }
+    };
+
+    HashValue(uint32(Plan.Channels.size()));
+    for (const std::string& Channel : Plan.Channels)
+        HashString(Channel.c_str());
 
-    for (const ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+    HashValue(Plan.Scenes.Num());
+    for (const FSceneLevels& Scene : Plan.Scenes)
     {
-        if (StreamingLevel->IsLevelLoaded())
-            UpdateLevelChannelCache(StreamingLevel->GetLoadedLevel());
+        const FRenderStreamSchemaIndex::FLevel& Level = Index.Level(Scene.Level);
+        HashString(Index.String(Level.Path));
+        HashParameters(Scene.Persistent != INDEX_NONE ? &Index.Level(Scene.Persistent) : nullptr);
+        HashParameters(&Level);
     }
 
-    // Loop over all levels and make sure caches exist for them.
-    TArray<FAssetData> LevelAssets;
-    const auto LevelLibrary = UObjectLibrary::CreateLibrary(ULevel::StaticClass(), false, true);
-    LevelLibrary->LoadAssetDataFromPath("/Game/");
-    LevelLibrary->GetAssetDataList(LevelAssets);
-    for (FAssetData const& Asset : LevelAssets)
-    {
-        // Create the required caches if they don't exist.
-        URenderStreamChannelCacheAsset* Cache;
-        if (!TryGetCache(CacheFolder + Asset.GetFullName(), Cache))
-            Cache = UpdateLevelChannelCache(Cast<ULevel>(Asset.FastGetAsset(true)));
-    }
+    Hash.Final();
+    uint8 Digest[FSHA1::DigestSize];
+    Hash.GetHash(Digest);
+    return BytesToHex(Digest, FSHA1::DigestSize);
 }
 
-URenderStreamChannelCacheAsset* GetDefaultMapCache()
+int32 FindDefaultMap(const FRenderStreamSchemaIndex& Index)
 {
     const FString DefaultMap = UGameMapsSettings::GetGameDefaultMap();
-    URenderStreamChannelCacheAsset* Cache = nullptr;
-    TryGetCache(DefaultMap, Cache);
-    // This should never be the case because we will have already generated all the caches for the levels previously.
-    if (!Cache)
-    {
-        const FSoftObjectPath Path(DefaultMap);
-        ULevel* Level = Cast<ULevel>(Path.TryLoad());
-        if (Level)
-            Cache = UpdateLevelChannelCache(Level);
-    }
-
-    return Cache;
+    const int32 Level = DefaultMap.IsEmpty() ? INDEX_NONE : Index.FindLevel(FPackageName::ObjectPathToPackageName(DefaultMap));
+    if (Level == INDEX_NONE)
+        UE_LOG(LogRenderStreamEditor, Error, TEXT("No default map defined, either use Maps scene selector or define a default map."));
+    return Level;
 }
 
-void FRenderStreamEditorModule::GenerateAssetMetadata()
+FRenderStreamSchemaPlan PlanSchema(const FRenderStreamSchemaIndex& Index)
 {
-    if (!RenderStreamLink::instance().isAvailable())
+    FRenderStreamSchemaPlan Plan;
+    for (uint32 i = 0; i < Index.NumLevels(); ++i)
     {
-        UE_LOG(LogRenderStreamEditor, Warning, TEXT("RenderStreamLink unavailable, skipped GenerateAssetMetadata"));
-        return;
+        const FRenderStreamSchemaIndex::FLevel& Level = Index.Level(i);
+        for (uint32 j = 0; j < Level.Channels.Num; ++j)
+            Plan.Channels.emplace(Index.String(Level.Channels, j));
     }
 
-    const URenderStreamSettings* settings = GetDefault<URenderStreamSettings>();
-
-    // Update currently loaded levels
-    UpdateChannelCache();
-
-    TArray<URenderStreamChannelCacheAsset*> ChannelCaches;
-    auto ObjectLibrary = UObjectLibrary::CreateLibrary(URenderStreamChannelCacheAsset::StaticClass(), false, false);
-    ObjectLibrary->LoadAssetsFromPath(CacheFolder);
-    ObjectLibrary->GetObjects(ChannelCaches);
-
-    TArray<FAssetData> CachesForDelete;
-    std::set<std::string> Channels;
-    TMap<FSoftObjectPath, URenderStreamChannelCacheAsset*> LevelParams;
-    for (size_t i = 0; i < ChannelCaches.Num(); ++i)
+    // Sub-levels are listed as object paths, the index by package name.
+    auto FindSubLevel = [&Index](const FRenderStreamSchemaIndex::FLevel& Level, uint32 SubLevel)
     {
-        URenderStreamChannelCacheAsset* Cache = ChannelCaches[i];
-        const FName PathName = Cache->Level.GetAssetPathName();
-        if (FPackageName::DoesPackageExist(PathName.ToString()))
-        {
-            for (const FString& Channel : Cache->Channels)
-            {
-                Channels.emplace(TCHAR_TO_ANSI(*Channel));
-            }
-
-            LevelParams.Add(Cache->Level) = Cache;
-        }
-        else
-        {
-            // Remove them so we don't process deleted caches.
-            CachesForDelete.Add(Cache->GetPackage());
-            ChannelCaches.RemoveAt(i);
-            --i;
-        }
-    }
-
-    RenderStreamLink::ScopedSchema Schema;
-    Schema.schema.channels.nChannels = uint32_t(Channels.size());
-    Schema.schema.channels.channels = static_cast<const char**>(malloc(Schema.schema.channels.nChannels * sizeof(const char*)));
-    auto It = Channels.begin();
-    for (size_t i = 0; i < Schema.schema.channels.nChannels && It != Channels.end(); ++i, ++It)
-        Schema.schema.channels.channels[i] = _strdup(It->c_str());
-
-    UWorld* World = GEditor->GetEditorWorldContext().World();
+        const FString Path = UTF8_TO_TCHAR(Index.String(Level.SubLevels, SubLevel));
+        const int32 Found = Index.FindLevel(FPackageName::ObjectPathToPackageName(Path));
+        if (Found == INDEX_NONE)
+            UE_LOG(LogRenderStreamEditor, Warning, TEXT("Sub-level %s is missing from the schema index, skipped it"), *Path);
+        return Found;
+    };
 
+    const URenderStreamSettings* settings = GetDefault<URenderStreamSettings>();
     switch (settings->SceneSelector)
     {
     case ERenderStreamSceneSelector::None:
     {
-        URenderStreamChannelCacheAsset* MainMap = GetDefaultMapCache();
-        if (MainMap)
-        {
-            Schema.schema.scenes.nScenes = 1;
-            Schema.schema.scenes.scenes = static_cast<RenderStreamLink::RemoteParameters*>(malloc(Schema.schema.scenes.nScenes * sizeof(RenderStreamLink::RemoteParameters)));
-            GenerateScene(*Schema.schema.scenes.scenes, MainMap, nullptr);
-        }
-        else
-            UE_LOG(LogRenderStreamEditor, Error, TEXT("No default map defined, either use Maps scene selector or define a default map."));
+        const int32 MainMap = FindDefaultMap(Index);
+        if (MainMap != INDEX_NONE)
+            Plan.Scenes.Add({ MainMap, INDEX_NONE });
 
         break;
     }
 
     case ERenderStreamSceneSelector::StreamingLevels:
+    case ERenderStreamSceneSelector::ResidentLevels:
     {
-        URenderStreamChannelCacheAsset* MainMap = GetDefaultMapCache();
-        if (MainMap)
+        const int32 MainMap = FindDefaultMap(Index);
+        if (MainMap != INDEX_NONE)
         {
-            Schema.schema.scenes.nScenes = 1 + MainMap->SubLevels.Num();
-            Schema.schema.scenes.scenes = static_cast<RenderStreamLink::RemoteParameters*>(malloc(Schema.schema.scenes.nScenes * sizeof(RenderStreamLink::RemoteParameters)));
-            RenderStreamLink::RemoteParameters* SceneParameters = Schema.schema.scenes.scenes;
-
-            GenerateScene(*SceneParameters++, MainMap, nullptr);
-            for (FSoftObjectPath Path : MainMap->SubLevels)
-                GenerateScene(*SceneParameters++, LevelParams[Path], MainMap);
+            Plan.Scenes.Add({ MainMap, INDEX_NONE });
+            const FRenderStreamSchemaIndex::FLevel& Level = Index.Level(MainMap);
+            for (uint32 i = 0; i < Level.SubLevels.Num; ++i)
+            {
+                const int32 SubLevel = FindSubLevel(Level, i);
+                if (SubLevel != INDEX_NONE)
+                    Plan.Scenes.Add({ SubLevel, MainMap });
+            }
         }
-        else
-            UE_LOG(LogRenderStreamEditor, Error, TEXT("No default map defined, either use Maps scene selector or define a default map."));
 
         break;
     }
 
     case ERenderStreamSceneSelector::Maps:
     {
-        TMap<const URenderStreamChannelCacheAsset*, const URenderStreamChannelCacheAsset*> LevelParents;
-        for (const URenderStreamChannelCacheAsset* Cache : ChannelCaches)
+        TArray<int32> LevelParents;
+        LevelParents.Init(INDEX_NONE, Index.NumLevels());
+        for (uint32 i = 0; i < Index.NumLevels(); ++i)
         {
-            for (FSoftObjectPath Path : Cache->SubLevels)
-                LevelParents.Add(LevelParams[Path], Cache);
+            const FRenderStreamSchemaIndex::FLevel& Level = Index.Level(i);
+            for (uint32 j = 0; j < Level.SubLevels.Num; ++j)
+            {
+                const int32 SubLevel = FindSubLevel(Level, j);
+                if (SubLevel != INDEX_NONE)
+                    LevelParents[SubLevel] = int32(i);
+            }
         }
 
-        Schema.schema.scenes.nScenes = ChannelCaches.Num();
-        Schema.schema.scenes.scenes = static_cast<RenderStreamLink::RemoteParameters*>(malloc(Schema.schema.scenes.nScenes * sizeof(RenderStreamLink::RemoteParameters)));
-        RenderStreamLink::RemoteParameters* SceneParameters = Schema.schema.scenes.scenes;
-        
-        for (const URenderStreamChannelCacheAsset* Cache : ChannelCaches)
-        {
-            const URenderStreamChannelCacheAsset** Entry = LevelParents.Find(Cache);
-            GenerateScene(*SceneParameters++, Cache, Entry != nullptr ? *Entry : nullptr);
-        }
+        for (uint32 i = 0; i < Index.NumLevels(); ++i)
+            Plan.Scenes.Add({ int32(i), LevelParents[i] });
 
         break;
     }
     }
 
-    if (RenderStreamLink::instance().rs_saveSchema(TCHAR_TO_UTF8(*FPaths::GetProjectFilePath()), &Schema.schema) != RenderStreamLink::RS_ERROR_SUCCESS)
+    return Plan;
+}
+
+RenderStreamLink::ScopedSchema BuildSchema(const FRenderStreamSchemaIndex& Index, const FRenderStreamSchemaPlan& Plan)
+{
+    // Scenes share most of their strings, the builder interns them and lays the schema out in one allocation.
+    FRenderStreamSchemaBuilder Builder;
+    for (const std::string& Channel : Plan.Channels)
+        Builder.AddChannel(Channel.c_str());
+    for (const FSceneLevels& Scene : Plan.Scenes)
+        GenerateScene(Builder, Index, Scene);
+    return Builder.Build();
+}
+
+void FRenderStreamEditorModule::GenerateAssetMetadata()
+{
+    if (!RenderStreamLink::instance().isAvailable())
+    {
+        UE_LOG(LogRenderStreamEditor, Warning, TEXT("RenderStreamLink unavailable, skipped GenerateAssetMetadata"));
+        return;
+    }
+
+    if (!UpdateSchemaIndex())
+    {
+        UE_LOG(LogRenderStreamEditor, Warning, TEXT("Schema index update cancelled, the schema was not saved"));
+        return;
+    }
+
+    TUniquePtr<FRenderStreamSchemaIndex> Index = FRenderStreamSchemaIndex::Open(FRenderStreamSchemaIndex::DefaultPath());
+    if (!Index)
     {
-        UE_LOG(LogRenderStreamEditor, Error, TEXT("Failed to save schema"));
+        UE_LOG(LogRenderStreamEditor, Error, TEXT("Failed to open schema index %s, the schema was not saved"), *FRenderStreamSchemaIndex::DefaultPath());
+        return;
     }
 
-    ObjectLibrary->ClearLoaded();
-    DeleteCaches(CachesForDelete);
+    const FRenderStreamSchemaPlan Plan = PlanSchema(*Index);
+    const FString SchemaHash = HashSchema(*Index, Plan);
+    if (SchemaHash == LastSavedSchemaHash)
+    {
+        UE_LOG(LogRenderStreamEditor, Log, TEXT("Schema unchanged, skipped saving it"));
+    }
+    else
+    {
+        RenderStreamLink::ScopedSchema Schema = BuildSchema(*Index, Plan);
+        if (RenderStreamLink::instance().rs_saveSchema(TCHAR_TO_UTF8(*FPaths::GetProjectFilePath()), &Schema.schema) != RenderStreamLink::RS_ERROR_SUCCESS)
+        {
+            UE_LOG(LogRenderStreamEditor, Error, TEXT("Failed to save schema"));
+        }
+        else
+        {
+            LastSavedSchemaHash = SchemaHash;
+        }
+    }
+
+    // Per-level cache assets are superseded by the index.
+    TArray<FAssetData> LegacyCaches;
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.GetAssetsByPath(FName(*CacheFolder), LegacyCaches, true);
+    DeleteCaches(LegacyCaches);
 }
 
 void FRenderStreamEditorModule::OnPostSaveWorld(uint32, UWorld* World, bool bSuccess)
@@ -537,6 +711,16 @@ void FRenderStreamEditorModule::OnPostSaveWorld(uint32, UWorld* World, bool bSuc
         DirtyAssetMetadata = true;
 }
 
+void FRenderStreamEditorModule::OnGetWorldAssetTags(const UWorld* World, TArray<UObject::FAssetRegistryTag>& OutTags)
+{
+    if (!World || !World->PersistentLevel)
+        return;
+
+    const FString Metadata = ExportLevelMetadata(ExtractLevelMetadata(World->PersistentLevel));
+    OutTags.Add(UObject::FAssetRegistryTag(LevelMetadataTag, Metadata, UObject::FAssetRegistryTag::TT_Hidden));
+    OutTags.Add(UObject::FAssetRegistryTag(LevelMetadataHashTag, LevelMetadataHash(Metadata), UObject::FAssetRegistryTag::TT_Hidden));
+}
+
 void FRenderStreamEditorModule::OnAssetsDeleted(const TArray<UClass*>& DeletedAssetClasses)
 {
     if (DeletedAssetClasses.Contains(UWorld::StaticClass()))
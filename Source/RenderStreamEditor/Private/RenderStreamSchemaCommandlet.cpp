@@ -0,0 +1,135 @@
+#include "RenderStreamSchemaCommandlet.h"
+
+#include "RenderStreamEditorModule.h"
+#include "RenderStreamSchemaGeneration.h"
+#include "RenderStreamSchemaIndex.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace {
+    // The schema as rs_saveSchema receives it, for pipelines without d3 installed.
+    TSharedRef<FJsonObject> SchemaToJson(const RenderStreamLink::Schema& Schema)
+    {
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+
+        TArray<TSharedPtr<FJsonValue>> Channels;
+        for (uint32_t i = 0; i < Schema.channels.nChannels; ++i)
+            Channels.Add(MakeShared<FJsonValueString>(UTF8_TO_TCHAR(Schema.channels.channels[i])));
+        Json->SetArrayField(TEXT("channels"), Channels);
+
+        TArray<TSharedPtr<FJsonValue>> Scenes;
+        for (uint32_t i = 0; i < Schema.scenes.nScenes; ++i)
+        {
+            const RenderStreamLink::RemoteParameters& Scene = Schema.scenes.scenes[i];
+            TSharedRef<FJsonObject> SceneJson = MakeShared<FJsonObject>();
+            SceneJson->SetStringField(TEXT("name"), UTF8_TO_TCHAR(Scene.name));
+
+            TArray<TSharedPtr<FJsonValue>> Parameters;
+            for (uint32_t j = 0; j < Scene.nParameters; ++j)
+            {
+                const RenderStreamLink::RemoteParameter& Parameter = Scene.parameters[j];
+                TSharedRef<FJsonObject> ParameterJson = MakeShared<FJsonObject>();
+                ParameterJson->SetStringField(TEXT("group"), UTF8_TO_TCHAR(Parameter.group));
+                ParameterJson->SetStringField(TEXT("displayName"), UTF8_TO_TCHAR(Parameter.displayName));
+                ParameterJson->SetStringField(TEXT("key"), UTF8_TO_TCHAR(Parameter.key));
+                ParameterJson->SetNumberField(TEXT("min"), Parameter.min);
+                ParameterJson->SetNumberField(TEXT("max"), Parameter.max);
+                ParameterJson->SetNumberField(TEXT("step"), Parameter.step);
+                ParameterJson->SetNumberField(TEXT("defaultValue"), Parameter.defaultValue);
+                TArray<TSharedPtr<FJsonValue>> Options;
+                for (uint32_t k = 0; k < Parameter.nOptions; ++k)
+                    Options.Add(MakeShared<FJsonValueString>(UTF8_TO_TCHAR(Parameter.options[k])));
+                ParameterJson->SetArrayField(TEXT("options"), Options);
+                ParameterJson->SetNumberField(TEXT("dmxOffset"), Parameter.dmxOffset);
+                ParameterJson->SetNumberField(TEXT("dmxType"), Parameter.dmxType);
+                Parameters.Add(MakeShared<FJsonValueObject>(ParameterJson));
+            }
+            SceneJson->SetArrayField(TEXT("parameters"), Parameters);
+            Scenes.Add(MakeShared<FJsonValueObject>(SceneJson));
+        }
+        Json->SetArrayField(TEXT("scenes"), Scenes);
+
+        return Json;
+    }
+}
+
+URenderStreamSchemaCommandlet::URenderStreamSchemaCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 URenderStreamSchemaCommandlet::Main(const FString& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const bool bRebuild = FParse::Param(*Params, TEXT("Rebuild"));
+    FString OutputPath;
+    const bool bOutput = FParse::Value(*Params, TEXT("Output="), OutputPath);
+    const bool bAvailable = RenderStreamLink::instance().isAvailable();
+    if (!bOutput)
+        OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RenderStream"), TEXT("Schema.json"));
+
+    // Commandlets start without the registry scanned, the levels and their tags come from it.
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    TArray<FRenderStreamLevelTiming> Timings;
+    if (!UpdateSchemaIndex(bRebuild, &Timings))
+    {
+        UE_LOG(LogRenderStreamEditor, Error, TEXT("Failed to update the schema index %s"), *FRenderStreamSchemaIndex::DefaultPath());
+        return 1;
+    }
+
+    for (const FRenderStreamLevelTiming& Timing : Timings)
+    {
+        UE_LOG(LogRenderStreamEditor, Display, TEXT("%s: %s, load %.1f ms, extract %.1f ms"), *Timing.LevelPath,
+            Timing.bExtracted ? TEXT("indexed") : TEXT("failed"), Timing.LoadTime * 1000.0, Timing.ExtractTime * 1000.0);
+    }
+
+    TUniquePtr<FRenderStreamSchemaIndex> Index = FRenderStreamSchemaIndex::Open(FRenderStreamSchemaIndex::DefaultPath());
+    if (!Index)
+    {
+        UE_LOG(LogRenderStreamEditor, Error, TEXT("Failed to open schema index %s"), *FRenderStreamSchemaIndex::DefaultPath());
+        return 1;
+    }
+
+    const FRenderStreamSchemaPlan Plan = PlanSchema(*Index);
+    if (Plan.Scenes.Num() == 0)
+    {
+        UE_LOG(LogRenderStreamEditor, Error, TEXT("The schema has no scenes, check the scene selector and default map in the project settings"));
+        return 1;
+    }
+    RenderStreamLink::ScopedSchema Schema = BuildSchema(*Index, Plan);
+
+    if (bAvailable)
+    {
+        if (RenderStreamLink::instance().rs_saveSchema(TCHAR_TO_UTF8(*FPaths::GetProjectFilePath()), &Schema.schema) != RenderStreamLink::RS_ERROR_SUCCESS)
+        {
+            UE_LOG(LogRenderStreamEditor, Error, TEXT("Failed to save schema"));
+            return 1;
+        }
+        UE_LOG(LogRenderStreamEditor, Display, TEXT("Saved schema for %s"), *FPaths::GetProjectFilePath());
+    }
+
+    if (bOutput || !bAvailable)
+    {
+        FString Output;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+        FJsonSerializer::Serialize(SchemaToJson(Schema.schema), Writer);
+        if (!FFileHelper::SaveStringToFile(Output, *OutputPath))
+        {
+            UE_LOG(LogRenderStreamEditor, Error, TEXT("Unable to write the schema to '%s'"), *OutputPath);
+            return 1;
+        }
+        UE_LOG(LogRenderStreamEditor, Display, TEXT("Wrote schema to %s"), *OutputPath);
+    }
+
+    UE_LOG(LogRenderStreamEditor, Display, TEXT("Generated %d scenes with %d channels from %u levels, indexed %d, in %.1f ms"),
+        Plan.Scenes.Num(), int32(Plan.Channels.size()), Index->NumLevels(), Timings.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderStreamLink.h"
+
+#include <set>
+#include <string>
+
+class FRenderStreamSchemaIndex;
+
+// Schema generation shared by the editor module and the RenderStreamSchema commandlet, see RenderStreamEditorModule.cpp.
+
+// How long indexing one level took.
+struct FRenderStreamLevelTiming
+{
+    FString LevelPath;
+    double LoadTime; // only for levels saved without metadata tags
+    double ExtractTime;
+    bool bExtracted;
+};
+
+// A scene is its level's parameters, after those of the persistent level it is streamed into if any.
+struct FSceneLevels
+{
+    int32 Level;
+    int32 Persistent;
+};
+
+// What goes into the schema for the project's scene selector, as indices into the schema index.
+struct FRenderStreamSchemaPlan
+{
+    std::set<std::string> Channels;
+    TArray<FSceneLevels> Scenes;
+};
+
+// Brings the schema index up to date with every level under /Game/, returns false when cancelled or it could not be
+// saved. Rebuild ignores the existing index and extracts every level again.
+bool UpdateSchemaIndex(bool bRebuild = false, TArray<FRenderStreamLevelTiming>* OutTimings = nullptr);
+
+FRenderStreamSchemaPlan PlanSchema(const FRenderStreamSchemaIndex& Index);
+// Covers everything the schema is generated from in the order it is written, equal hashes mean an identical schema.
+FString HashSchema(const FRenderStreamSchemaIndex& Index, const FRenderStreamSchemaPlan& Plan);
+RenderStreamLink::ScopedSchema BuildSchema(const FRenderStreamSchemaIndex& Index, const FRenderStreamSchemaPlan& Plan);
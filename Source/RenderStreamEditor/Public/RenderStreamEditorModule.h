@@ -2,6 +2,7 @@
 
 #include "Core.h"
 #include "Modules/ModuleInterface.h"
+#include "UObject/Object.h"
 
 class ULevel;
 class UWorld;
@@ -25,6 +26,8 @@ private:
     // Delegates
     void OnBeginFrame();
     void OnPostSaveWorld(uint32 SaveFlags, UWorld* World, bool bSuccess);
+    // Stores each level's channels and parameters in the asset registry, so caches can be built without loading it.
+    void OnGetWorldAssetTags(const UWorld* World, TArray<UObject::FAssetRegistryTag>& OutTags);
     void OnAssetsDeleted(const TArray<UClass*>& DeletedAssetClasses);
 
     void OnPostEngineInit();
@@ -34,4 +37,6 @@ private:
 
     TWeakObjectPtr<UWorld> GameWorld;
     bool DirtyAssetMetadata = false;
+    // Hash of the schema last passed to rs_saveSchema, an unchanged schema isn't saved again.
+    FString LastSavedSchemaHash;
 };
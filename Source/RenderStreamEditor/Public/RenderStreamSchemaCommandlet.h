@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "RenderStreamSchemaCommandlet.generated.h"
+
+/**
+ * Generates the schema index and the schema for every map in the project without the editor UI, for build pipelines.
+ * Levels are indexed from their asset registry tags in parallel, levels saved without tags are loaded first.
+ *
+ * UE4Editor-Cmd.exe <Project> -run=RenderStreamSchema [-Rebuild] [-Output=<File>]
+ *
+ * The schema is saved with rs_saveSchema when the RenderStream library is available, and written as JSON to Output
+ * when it is not or when Output is given. Rebuild ignores the existing index and indexes every level again.
+ */
+UCLASS()
+class URenderStreamSchemaCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URenderStreamSchemaCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};